@@ -334,14 +334,37 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     # Include files used by all split keyboards
     QUANTUM_SRC += $(QUANTUM_DIR)/split_common/split_util.c
 
+    ifeq ($(strip $(SPLIT_LINK_STATS_ENABLE)), yes)
+        OPT_DEFS += -DSPLIT_LINK_STATS_ENABLE
+        QUANTUM_SRC += $(QUANTUM_DIR)/split_common/split_stats.c
+    endif
+
     # Determine which (if any) transport files are required
-    ifneq ($(strip $(SPLIT_TRANSPORT)), custom)
-        QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport.c
+    ifeq ($(strip $(SPLIT_TRANSPORT)), serial_link)
+        OPT_DEFS += -DSPLIT_TRANSPORT_SERIAL_LINK
+        QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport_serial_link.c \
+                       $(QUANTUM_DIR)/split_common/serial_link_usart.c \
+                       $(QUANTUM_DIR)/split_common/matrix_delta.c \
+                       $(SERIAL_DIR)/protocol/byte_stuffer.c \
+                       $(SERIAL_DIR)/protocol/frame_validator.c \
+                       $(SERIAL_DIR)/protocol/frame_router.c \
+                       $(SERIAL_DIR)/protocol/transport.c \
+                       $(SERIAL_DIR)/protocol/triple_buffered_object.c
+    else ifneq ($(strip $(SPLIT_TRANSPORT)), custom)
+        QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport.c \
+                       $(QUANTUM_DIR)/split_common/matrix_delta.c \
+                       $(QUANTUM_DIR)/split_common/split_scheduler.c
         # Functions added via QUANTUM_LIB_SRC are only included in the final binary if they're called.
         # Unused functions are pruned away, which is why we can add multiple drivers here without bloat.
-        QUANTUM_LIB_SRC += $(QUANTUM_DIR)/split_common/serial.c \
-                           i2c_master.c \
+        QUANTUM_LIB_SRC += i2c_master.c \
                            i2c_slave.c
+        ifeq ($(strip $(SERIAL_DRIVER)), usart)
+            OPT_DEFS += -DSERIAL_USART
+            QUANTUM_LIB_SRC += $(QUANTUM_DIR)/split_common/serial_usart.c \
+                               $(QUANTUM_DIR)/split_common/serial_frame.c
+        else
+            QUANTUM_LIB_SRC += $(QUANTUM_DIR)/split_common/serial.c
+        endif
     endif
     COMMON_VPATH += $(QUANTUM_PATH)/split_common
 endif
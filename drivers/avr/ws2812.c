@@ -26,6 +26,9 @@
 #include <avr/io.h>
 #include <util/delay.h>
 #include "debug.h"
+#ifdef WS2812_PARALLEL_PINS
+#include "ws2812_parallel.h"
+#endif
 
 #if !defined(LED_ARRAY) && defined(RGB_MATRIX_ENABLE)
 // LED color buffer
@@ -169,8 +172,12 @@ void ws2812_setled_all  (uint8_t r, uint8_t g, uint8_t b)
 // Setleds for standard RGB
 void inline ws2812_setleds(LED_TYPE *ledarray, uint16_t leds)
 {
+#ifdef WS2812_PARALLEL_PINS
+   ws2812_setleds_parallel(ledarray, leds);
+#else
    // ws2812_setleds_pin(ledarray,leds, _BV(ws2812_pin));
    ws2812_setleds_pin(ledarray,leds, _BV(RGB_DI_PIN & 0xF));
+#endif
 }
 
 void inline ws2812_setleds_pin(LED_TYPE *ledarray, uint16_t leds, uint8_t pinmask)
@@ -365,3 +372,164 @@ w_nop16
 
   SREG=sreg_prev;
 }
+
+#ifdef WS2812_PARALLEL_PINS
+/*
+  Parallel output: up to 8 strips on pins of the port of RGB_DI_PIN are sent
+  at the same time. ws2812_setleds splits the LED array into consecutive
+  ranges of WS2812_PARALLEL_LEDS LEDs, one per pin of WS2812_PARALLEL_PINS,
+  encodes them into bit planes with interrupts still enabled and then writes
+  one plane to the port every 1.25us.
+*/
+
+#ifndef WS2812_PARALLEL_LEDS
+  #error "WS2812_PARALLEL_PINS needs WS2812_PARALLEL_LEDS, the number of LEDs on each strip"
+#endif
+
+#define WS2812_PARALLEL_STRIPS (sizeof((uint8_t[])WS2812_PARALLEL_PINS))
+
+// Longest strip, sets the size of the plane buffer: 24 bytes per LED. Longer
+// strips are cut off, and the preprocessor can't take the maximum of
+// WS2812_PARALLEL_LEDS, so there is no default.
+#ifndef WS2812_PARALLEL_MAX_LEDS
+  #error "WS2812_PARALLEL_PINS needs WS2812_PARALLEL_MAX_LEDS, the number of LEDs on the longest strip"
+#endif
+
+static const uint8_t  ws2812_parallel_pins[] = WS2812_PARALLEL_PINS;
+static const uint16_t ws2812_parallel_leds[] = WS2812_PARALLEL_LEDS;
+
+_Static_assert(sizeof(ws2812_parallel_pins) <= 8, "WS2812_PARALLEL_PINS can hold at most 8 pins");
+_Static_assert(sizeof(ws2812_parallel_leds) / sizeof(ws2812_parallel_leds[0]) == sizeof(ws2812_parallel_pins), "WS2812_PARALLEL_LEDS needs one entry per pin of WS2812_PARALLEL_PINS");
+
+static ws2812_strip_t ws2812_strips[WS2812_PARALLEL_STRIPS];
+static uint8_t        ws2812_strips_mask;
+static uint8_t        ws2812_planes[WS2812_PARALLEL_MAX_LEDS * sizeof(LED_TYPE) * 8];
+
+// Cycles used by the parallel loop, counted from the rising edge
+#define pw_fixedlow    4
+#define pw_fixedhigh   5
+#define pw_fixedtotal  10
+
+#define pw1 (w_zerocycles-pw_fixedlow)
+#define pw2 (w_onecycles-pw_fixedhigh-pw1)
+#define pw3 (w_totalcycles-pw_fixedtotal-pw1-pw2)
+
+#if pw1>0
+  #define pw1_nops pw1
+#else
+  #define pw1_nops  0
+#endif
+
+#define pw_lowtime ((pw1_nops+pw_fixedlow)*1000000)/(F_CPU/1000)
+#if pw_lowtime>550
+   #error "Light_ws2812: The clock speed is too low for WS2812_PARALLEL_PINS."
+#elif pw_lowtime>450
+   #warning "Light_ws2812: The timing of WS2812_PARALLEL_PINS is critical and may only work on WS2812B, not on WS2812(S)."
+#endif
+
+#if pw2>0
+#define pw2_nops pw2
+#else
+#define pw2_nops  0
+#endif
+
+#if pw3>0
+#define pw3_nops pw3
+#else
+#define pw3_nops  0
+#endif
+
+static void ws2812_sendplanes(const uint8_t *planes, uint16_t count)
+{
+  uint8_t masklo,maskhi,curplane;
+  uint8_t sreg_prev;
+
+  if (!count) {
+    return;
+  }
+
+  sreg_prev=SREG;
+  cli();
+  masklo  =~ws2812_strips_mask&_SFR_IO8((RGB_DI_PIN >> 4) + 2);
+  maskhi  = ws2812_strips_mask|masklo;
+
+  asm volatile(
+  "loop%=:                \n\t"
+  "       out   %3,%4     \n\t"    //  [01] - re of every strip
+  "       ld    %0,%a2+   \n\t"    //  [03]
+  "       or    %0,%5     \n\t"    //  [04]
+#if (pw1_nops&1)
+w_nop1
+#endif
+#if (pw1_nops&2)
+w_nop2
+#endif
+#if (pw1_nops&4)
+w_nop4
+#endif
+#if (pw1_nops&8)
+w_nop8
+#endif
+#if (pw1_nops&16)
+w_nop16
+#endif
+  "       out   %3,%0     \n\t"    //  [05] - fe of the strips sending a '0'
+#if (pw2_nops&1)
+  w_nop1
+#endif
+#if (pw2_nops&2)
+  w_nop2
+#endif
+#if (pw2_nops&4)
+  w_nop4
+#endif
+#if (pw2_nops&8)
+  w_nop8
+#endif
+#if (pw2_nops&16)
+  w_nop16
+#endif
+  "       out   %3,%5     \n\t"    //  [+1] - fe of the strips sending a '1'
+#if (pw3_nops&1)
+w_nop1
+#endif
+#if (pw3_nops&2)
+w_nop2
+#endif
+#if (pw3_nops&4)
+w_nop4
+#endif
+#if (pw3_nops&8)
+w_nop8
+#endif
+#if (pw3_nops&16)
+w_nop16
+#endif
+  "       sbiw  %1,1      \n\t"    //  [+3]
+  "       brne  loop%=    \n\t"    //  [+5]
+  :	"=&r" (curplane), "+w" (count), "+e" (planes)
+  :	"I" (_SFR_IO_ADDR(_SFR_IO8((RGB_DI_PIN >> 4) + 2))), "r" (maskhi), "r" (masklo)
+  );
+
+  SREG=sreg_prev;
+}
+
+void ws2812_setleds_parallel(LED_TYPE *ledarray, uint16_t leds)
+{
+  if (!ws2812_strips_mask) {
+    uint16_t start = 0;
+    for (uint8_t i = 0; i < WS2812_PARALLEL_STRIPS; i++) {
+      ws2812_strips[i].pinmask = _BV(ws2812_parallel_pins[i] & 0xF);
+      ws2812_strips[i].start   = start;
+      ws2812_strips[i].count   = ws2812_parallel_leds[i];
+      ws2812_strips_mask      |= ws2812_strips[i].pinmask;
+      start                   += ws2812_parallel_leds[i];
+    }
+  }
+  _SFR_IO8((RGB_DI_PIN >> 4) + 1) |= ws2812_strips_mask;
+
+  uint16_t slots = ws2812_parallel_encode(ws2812_planes, (const uint8_t *)ledarray, leds, sizeof(LED_TYPE), ws2812_strips, WS2812_PARALLEL_STRIPS, WS2812_PARALLEL_MAX_LEDS);
+  ws2812_sendplanes(ws2812_planes, slots * sizeof(LED_TYPE) * 8);
+  _delay_us(50);
+}
+#endif
@@ -50,6 +50,9 @@ void ws2812_setled_all  (uint8_t r, uint8_t g, uint8_t b);
 void ws2812_setleds     (LED_TYPE *ledarray, uint16_t number_of_leds);
 void ws2812_setleds_pin (LED_TYPE *ledarray, uint16_t number_of_leds,uint8_t pinmask);
 void ws2812_setleds_rgbw(LED_TYPE *ledarray, uint16_t number_of_leds);
+#ifdef WS2812_PARALLEL_PINS
+void ws2812_setleds_parallel(LED_TYPE *ledarray, uint16_t number_of_leds);
+#endif
 
 /*
  * Old interface / Internal functions
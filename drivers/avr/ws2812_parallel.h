@@ -0,0 +1,86 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Bit-plane encoding for driving up to 8 WS2812 strips at once from pins of
+ * the same port.
+ *
+ * The strips are clocked out together, so bit n of every strip goes out in
+ * the same 1.25us slot. For each slot the encoder produces one plane: a port
+ * value with the pin of every strip whose bit n is 1 set. The send loop then
+ * only has to write the planes to the port in order, and the time interrupts
+ * are off is that of the longest strip instead of that of all strips.
+ *
+ * Kept free of AVR headers so the encoding can be tested on the host.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+  // Bit of the strip's data pin in the port
+  uint8_t pinmask;
+  // The strip's LEDs in the LED array
+  uint16_t start;
+  uint16_t count;
+} ws2812_strip_t;
+
+/** \brief Encodes an LED array into bit planes
+ *
+ * leds holds bytes_per_led bytes per LED in the order they are sent. Strips
+ * are cut off at max_slots LEDs and at the end of the LED array, shorter
+ * strips are padded with zeros.
+ *
+ * Returns the number of LEDs of the longest strip, planes then holds
+ * bytes_per_led * 8 planes for each of them.
+ */
+static inline uint16_t ws2812_parallel_encode(uint8_t *planes, const uint8_t *leds, uint16_t leds_total, uint8_t bytes_per_led, const ws2812_strip_t *strips, uint8_t strip_count, uint16_t max_slots) {
+  uint16_t slots = 0;
+  memset(planes, 0, (uint32_t)max_slots * bytes_per_led * 8);
+
+  for (uint8_t s = 0; s < strip_count; s++) {
+    uint16_t count = strips[s].count;
+    if (count > max_slots) {
+      count = max_slots;
+    }
+    if (strips[s].start >= leds_total) {
+      continue;
+    }
+    if (count > leds_total - strips[s].start) {
+      count = leds_total - strips[s].start;
+    }
+    if (count > slots) {
+      slots = count;
+    }
+
+    uint8_t        mask  = strips[s].pinmask;
+    const uint8_t *data  = leds + (uint32_t)strips[s].start * bytes_per_led;
+    uint8_t *      plane = planes;
+    for (uint16_t n = (uint16_t)count * bytes_per_led; n; n--) {
+      uint8_t byte = *data++;
+      // most significant bit first
+      for (uint8_t bit = 0x80; bit; bit >>= 1) {
+        if (byte & bit) {
+          *plane |= mask;
+        }
+        plane++;
+      }
+    }
+  }
+  return slots;
+}
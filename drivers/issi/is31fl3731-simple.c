@@ -75,7 +75,9 @@ uint8_t g_twi_transfer_buffer[20];
 // buffers and the transfers in IS31FL3731_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[LED_DRIVER_COUNT][144];
-bool g_pwm_buffer_update_required = false;
+// One bit per 16 byte transfer of each g_pwm_buffer, set while that part
+// holds changes the driver has not been sent yet
+uint16_t g_pwm_buffer_dirty[LED_DRIVER_COUNT];
 
 /* There's probably a better way to init this... */
 #if LED_DRIVER_COUNT == 1
@@ -119,14 +121,18 @@ void IS31FL3731_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     #endif
 }
 
-void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static void IS31FL3731_write_pwm_chunks(uint8_t addr, uint8_t *pwm_buffer, uint16_t chunks) {
     // assumes bank is already selected
 
-    // transmit PWM registers in 9 transfers of 16 bytes
+    // transmit PWM registers in up to 9 transfers of 16 bytes,
+    // one for each bit set in chunks
     // g_twi_transfer_buffer[] is 20 bytes
 
     // iterate over the pwm_buffer contents at 16 byte intervals
     for (int i = 0; i < 144; i += 16) {
+        if (!(chunks & (1 << (i / 16)))) {
+            continue;
+        }
         // set the first register, e.g. 0x24, 0x34, 0x44, etc.
         g_twi_transfer_buffer[0] = 0x24 + i;
         // copy the data from i to i+15
@@ -147,6 +153,10 @@ void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     }
 }
 
+void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    IS31FL3731_write_pwm_chunks(addr, pwm_buffer, 0x01FF);
+}
+
 void IS31FL3731_init(uint8_t addr) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, first enable software shutdown,
@@ -185,6 +195,11 @@ void IS31FL3731_init(uint8_t addr) {
     for (int i = 0x24; i <= 0xB3; i++) {
         IS31FL3731_write_register(addr, i, 0x00);
     }
+    // We don't know which buffer is this chip's, so send them all in full
+    // on the next update.
+    for (int i = 0; i < LED_DRIVER_COUNT; i++) {
+        g_pwm_buffer_dirty[i] = 0x01FF;
+    }
 
     // select "function register" bank
     IS31FL3731_write_register(addr, ISSI_COMMANDREGISTER, ISSI_BANK_FUNCTIONREG);
@@ -204,8 +219,11 @@ void IS31FL3731_set_value(int index, uint8_t value) {
         is31_led led = g_is31_leds[index];
 
         // Subtract 0x24 to get the second index of g_pwm_buffer
-        g_pwm_buffer[led.driver][led.v - 0x24] = value;
-        g_pwm_buffer_update_required = true;
+        uint8_t i = led.v - 0x24;
+        if (g_pwm_buffer[led.driver][i] != value) {
+            g_pwm_buffer[led.driver][i] = value;
+            g_pwm_buffer_dirty[led.driver] |= 1 << (i / 16);
+        }
     }
 }
 
@@ -231,10 +249,8 @@ void IS31FL3731_set_led_control_register(uint8_t index, bool value) {
 }
 
 void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required) {
-        IS31FL3731_write_pwm_buffer(addr, g_pwm_buffer[index]);
-        g_pwm_buffer_update_required = false;
-    }
+    IS31FL3731_write_pwm_chunks(addr, g_pwm_buffer[index], g_pwm_buffer_dirty[index]);
+    g_pwm_buffer_dirty[index] = 0;
 }
 
 void IS31FL3731_update_led_control_registers(uint8_t addr, uint8_t index) {
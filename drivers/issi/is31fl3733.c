@@ -75,7 +75,9 @@ uint8_t g_twi_transfer_buffer[20];
 // buffers and the transfers in IS31FL3733_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[DRIVER_COUNT][192];
-bool g_pwm_buffer_update_required = false;
+// One bit per 16 byte transfer of each g_pwm_buffer, set while that part
+// holds changes the driver has not been sent yet
+uint16_t g_pwm_buffer_dirty[DRIVER_COUNT];
 
 uint8_t g_led_control_registers[DRIVER_COUNT][24] = { { 0 }, { 0 } };
 bool g_led_control_registers_update_required = false;
@@ -95,15 +97,19 @@ void IS31FL3733_write_register( uint8_t addr, uint8_t reg, uint8_t data )
   #endif
 }
 
-void IS31FL3733_write_pwm_buffer( uint8_t addr, uint8_t *pwm_buffer )
+static void IS31FL3733_write_pwm_chunks( uint8_t addr, uint8_t *pwm_buffer, uint16_t chunks )
 {
     // assumes PG1 is already selected
 
-    // transmit PWM registers in 12 transfers of 16 bytes
+    // transmit PWM registers in up to 12 transfers of 16 bytes,
+    // one for each bit set in chunks
     // g_twi_transfer_buffer[] is 20 bytes
 
     // iterate over the pwm_buffer contents at 16 byte intervals
     for ( int i = 0; i < 192; i += 16 ) {
+        if ( !( chunks & ( 1 << ( i / 16 ) ) ) ) {
+            continue;
+        }
         g_twi_transfer_buffer[0] = i;
         // copy the data from i to i+15
         // device will auto-increment register for data after the first byte
@@ -123,6 +129,11 @@ void IS31FL3733_write_pwm_buffer( uint8_t addr, uint8_t *pwm_buffer )
     }
 }
 
+void IS31FL3733_write_pwm_buffer( uint8_t addr, uint8_t *pwm_buffer )
+{
+    IS31FL3733_write_pwm_chunks( addr, pwm_buffer, 0x0FFF );
+}
+
 void IS31FL3733_init( uint8_t addr )
 {
     // In order to avoid the LEDs being driven with garbage data
@@ -152,6 +163,12 @@ void IS31FL3733_init( uint8_t addr )
     {
         IS31FL3733_write_register( addr, i, 0x00 );
     }
+    // We don't know which buffer is this chip's, so send them all in full
+    // on the next update.
+    for ( int i = 0; i < DRIVER_COUNT; i++ )
+    {
+        g_pwm_buffer_dirty[i] = 0x0FFF;
+    }
 
     // Unlock the command register.
     IS31FL3733_write_register( addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5 );
@@ -171,15 +188,22 @@ void IS31FL3733_init( uint8_t addr )
     #endif
 }
 
+static void IS31FL3733_set_pwm( uint8_t driver, uint8_t reg, uint8_t value )
+{
+    if ( g_pwm_buffer[driver][reg] != value ) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver] |= 1 << ( reg / 16 );
+    }
+}
+
 void IS31FL3733_set_color( int index, uint8_t red, uint8_t green, uint8_t blue )
 {
     if ( index >= 0 && index < DRIVER_LED_TOTAL ) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r] = red;
-        g_pwm_buffer[led.driver][led.g] = green;
-        g_pwm_buffer[led.driver][led.b] = blue;
-        g_pwm_buffer_update_required = true;
+        IS31FL3733_set_pwm( led.driver, led.r, red );
+        IS31FL3733_set_pwm( led.driver, led.g, green );
+        IS31FL3733_set_pwm( led.driver, led.b, blue );
     }
 }
 
@@ -224,16 +248,16 @@ void IS31FL3733_set_led_control_register( uint8_t index, bool red, bool green, b
 
 void IS31FL3733_update_pwm_buffers( uint8_t addr1, uint8_t addr2 )
 {
-    if ( g_pwm_buffer_update_required )
+    if ( g_pwm_buffer_dirty[0] )
     {
         // Firstly we need to unlock the command register and select PG1
         IS31FL3733_write_register( addr1, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5 );
         IS31FL3733_write_register( addr1, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM );
 
-        IS31FL3733_write_pwm_buffer( addr1, g_pwm_buffer[0] );
+        IS31FL3733_write_pwm_chunks( addr1, g_pwm_buffer[0], g_pwm_buffer_dirty[0] );
         //IS31FL3733_write_pwm_buffer( addr2, g_pwm_buffer[1] );
     }
-    g_pwm_buffer_update_required = false;
+    g_pwm_buffer_dirty[0] = 0;
 }
 
 void IS31FL3733_update_led_control_registers( uint8_t addr1, uint8_t addr2 )
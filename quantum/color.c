@@ -19,28 +19,38 @@
 #include "led_tables.h"
 #include "progmem.h"
 
-RGB hsv_to_rgb( HSV hsv )
+SV sv_prepare( uint8_t s, uint8_t v )
+{
+	SV sv;
+
+	sv.s = s;
+	sv.v = v;
+	sv.p = (v * (255 - s)) >> 8;
+	return sv;
+}
+
+RGB sv_hue_to_rgb( SV sv, uint8_t hue )
 {
 	RGB rgb;
-	uint8_t region, remainder, p, q, t;
+	uint8_t region, remainder, q, t;
 	uint16_t h, s, v;
 
-	if ( hsv.s == 0 )
+	if ( sv.s == 0 )
 	{
-		rgb.r = hsv.v;
-		rgb.g = hsv.v;
-		rgb.b = hsv.v;
+		rgb.r = sv.v;
+		rgb.g = sv.v;
+		rgb.b = sv.v;
 		return rgb;
 	}
 
-	h = hsv.h;
-	s = hsv.s;
-	v = hsv.v;
+	h = hue;
+	s = sv.s;
+	v = sv.v;
 
-	region = h * 6 / 255;
+	// h * 6 / 255 without the division, exact for every 8 bit hue
+	region = (h * 193) >> 13;
 	remainder = (h * 2 - region * 85) * 3;
 
-	p = (v * (255 - s)) >> 8;
 	q = (v * (255 - ((s * remainder) >> 8))) >> 8;
 	t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
 
@@ -50,31 +60,31 @@ RGB hsv_to_rgb( HSV hsv )
 		case 0:
 			rgb.r = v;
 			rgb.g = t;
-			rgb.b = p;
+			rgb.b = sv.p;
 			break;
 		case 1:
 			rgb.r = q;
 			rgb.g = v;
-			rgb.b = p;
+			rgb.b = sv.p;
 			break;
 		case 2:
-			rgb.r = p;
+			rgb.r = sv.p;
 			rgb.g = v;
 			rgb.b = t;
 			break;
 		case 3:
-			rgb.r = p;
+			rgb.r = sv.p;
 			rgb.g = q;
 			rgb.b = v;
 			break;
 		case 4:
 			rgb.r = t;
-			rgb.g = p;
+			rgb.g = sv.p;
 			rgb.b = v;
 			break;
 		default:
 			rgb.r = v;
-			rgb.g = p;
+			rgb.g = sv.p;
 			rgb.b = q;
 			break;
 	}
@@ -88,3 +98,7 @@ RGB hsv_to_rgb( HSV hsv )
 	return rgb;
 }
 
+RGB hsv_to_rgb( HSV hsv )
+{
+	return sv_hue_to_rgb( sv_prepare( hsv.s, hsv.v ), hsv.h );
+}
@@ -46,10 +46,22 @@ typedef struct PACKED
 	uint8_t v;
 } HSV;
 
+/* Saturation and value shared by a run of colors that differ only in
+ * hue, so the part of the conversion that doesn't depend on the hue is
+ * done once per run instead of once per color. */
+typedef struct PACKED
+{
+	uint8_t s;
+	uint8_t v;
+	uint8_t p;
+} SV;
+
 #if defined(_MSC_VER)
 #pragma pack( pop )
 #endif
 
 RGB hsv_to_rgb( HSV hsv );
+SV sv_prepare( uint8_t s, uint8_t v );
+RGB sv_hue_to_rgb( SV sv, uint8_t hue );
 
 #endif // COLOR_H
@@ -0,0 +1,76 @@
+/*
+Copyright 2019 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Asymmetric per-key algorithm, using bit-sliced counters.
+Key-down is eager: a press is pushed immediately, and the key then ignores
+its input for DEBOUNCE milliseconds.
+Key-up is deferred: a release is pushed only once the key has stayed up for
+DEBOUNCE milliseconds, any bounce back down restarts the wait.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include "bitsliced_counters.h"
+
+static debounce_counters_t debounce_counters[MATRIX_ROWS];
+static matrix_row_t        counting[MATRIX_ROWS];
+static matrix_row_t        locked[MATRIX_ROWS];
+static bool                counters_need_update;
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+  counters_reset(debounce_counters, num_rows);
+  memset(counting, 0, sizeof(counting));
+  memset(locked, 0, sizeof(locked));
+  counters_need_update = false;
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+  if (!changed && !counters_need_update) {
+    return;
+  }
+
+  uint8_t elapsed      = debounce_elapsed();
+  counters_need_update = false;
+  for (uint8_t row = 0; row < num_rows; row++) {
+    debounce_counters_t *counters = &debounce_counters[row];
+
+    // pressed keys that read as released, and are past their press lock
+    matrix_row_t releasing = cooked[row] & ~raw[row] & ~locked[row];
+    matrix_row_t bounced   = counting[row] & ~locked[row] & ~releasing;
+    counters_clear(counters, bounced | (releasing & ~counting[row]));
+    counters_add(counters, counting[row] & (locked[row] | releasing), elapsed);
+    counting[row] = locked[row] | releasing;
+
+    matrix_row_t done = counters_elapsed(counters) & counting[row];
+    counters_clear(counters, done);
+    cooked[row] &= ~(done & releasing);
+    locked[row] &= ~done;
+    counting[row] &= ~done;
+
+    matrix_row_t pressing = raw[row] & ~cooked[row] & ~counting[row];
+    cooked[row] |= pressing;
+    locked[row] |= pressing;
+    counting[row] |= pressing;
+
+    // a release seen during the press lock starts waiting once it ends
+    if (counting[row] || (cooked[row] & ~raw[row])) {
+      counters_need_update = true;
+    }
+  }
+}
+
+bool debounce_active(void) { return true; }
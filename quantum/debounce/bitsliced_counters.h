@@ -0,0 +1,113 @@
+/*
+Copyright 2019 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Bit-sliced debounce counters, shared by the sym_pk, sym_pr, eager_pr and
+asym_eager_defer_pk algorithms.
+
+Every key has a small millisecond counter, but the counters are stored
+sideways: plane[b] of a row holds bit b of the counter of every key in that
+row. Adding the elapsed time to all counting keys of a row, or checking which
+of them reached DEBOUNCE, is then a handful of bitwise operations on
+matrix_row_t values instead of a loop over the columns.
+*/
+
+#pragma once
+
+#include "matrix.h"
+#include "timer.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#  define DEBOUNCE 5
+#endif
+
+#if DEBOUNCE < 0 || DEBOUNCE > 255
+#  error "DEBOUNCE must be between 0 and 255"
+#elif DEBOUNCE < 2
+#  define DEBOUNCE_COUNTER_BITS 1
+#elif DEBOUNCE < 4
+#  define DEBOUNCE_COUNTER_BITS 2
+#elif DEBOUNCE < 8
+#  define DEBOUNCE_COUNTER_BITS 3
+#elif DEBOUNCE < 16
+#  define DEBOUNCE_COUNTER_BITS 4
+#elif DEBOUNCE < 32
+#  define DEBOUNCE_COUNTER_BITS 5
+#elif DEBOUNCE < 64
+#  define DEBOUNCE_COUNTER_BITS 6
+#elif DEBOUNCE < 128
+#  define DEBOUNCE_COUNTER_BITS 7
+#else
+#  define DEBOUNCE_COUNTER_BITS 8
+#endif
+
+#define DEBOUNCE_ROW_ALL ((matrix_row_t)~(matrix_row_t)0)
+
+typedef struct {
+  matrix_row_t plane[DEBOUNCE_COUNTER_BITS];
+} debounce_counters_t;
+
+static uint16_t debounce_last_time;
+
+// Milliseconds since the previous call, capped at DEBOUNCE
+static inline uint8_t debounce_elapsed(void) {
+  uint16_t now     = timer_read();
+  uint16_t elapsed = TIMER_DIFF_16(now, debounce_last_time);
+  debounce_last_time = now;
+  return elapsed > DEBOUNCE ? DEBOUNCE : elapsed;
+}
+
+static inline void counters_reset(debounce_counters_t *counters, uint8_t num_rows) {
+  memset(counters, 0, num_rows * sizeof(debounce_counters_t));
+  debounce_last_time = timer_read();
+}
+
+// Sets the counters of the keys in mask back to zero
+static inline void counters_clear(debounce_counters_t *counters, matrix_row_t mask) {
+  for (uint8_t b = 0; b < DEBOUNCE_COUNTER_BITS; b++) {
+    counters->plane[b] &= ~mask;
+  }
+}
+
+// Adds amount to the counters of the keys in mask, saturating at the maximum
+static inline void counters_add(debounce_counters_t *counters, matrix_row_t mask, uint8_t amount) {
+  matrix_row_t carry = 0;
+  for (uint8_t b = 0; b < DEBOUNCE_COUNTER_BITS; b++) {
+    matrix_row_t addend = (amount & (1 << b)) ? mask : 0;
+    matrix_row_t plane  = counters->plane[b];
+    counters->plane[b]  = plane ^ addend ^ carry;
+    carry               = (plane & addend) | (carry & (plane ^ addend));
+  }
+  if (carry) {
+    for (uint8_t b = 0; b < DEBOUNCE_COUNTER_BITS; b++) {
+      counters->plane[b] |= carry;
+    }
+  }
+}
+
+// Returns the keys whose counter is at least DEBOUNCE
+static inline matrix_row_t counters_elapsed(const debounce_counters_t *counters) {
+  matrix_row_t greater = 0;
+  matrix_row_t equal   = DEBOUNCE_ROW_ALL;
+  for (int8_t b = DEBOUNCE_COUNTER_BITS - 1; b >= 0; b--) {
+    if (DEBOUNCE & (1 << b)) {
+      equal &= counters->plane[b];
+    } else {
+      greater |= equal & counters->plane[b];
+      equal &= ~counters->plane[b];
+    }
+  }
+  return greater | equal;
+}
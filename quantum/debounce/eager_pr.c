@@ -13,82 +13,55 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 /*
-Basic per-row algorithm. Uses an 8-bit counter per row.
-After pressing a key, it immediately changes state, and sets a counter.
-No further inputs are accepted until DEBOUNCE milliseconds have occurred.
+Basic per-row algorithm, using bit-sliced counters.
+After pressing a key, it immediately changes state, and starts the counter of
+its row. No further inputs are accepted on that row until DEBOUNCE
+milliseconds have occurred.
+The row counter is kept in every column of the row, so it shares the
+per-key counter code.
 */
 
 #include "matrix.h"
 #include "timer.h"
 #include "quantum.h"
-#include <stdlib.h>
+#include "bitsliced_counters.h"
 
-#ifndef DEBOUNCE
-#  define DEBOUNCE 5
-#endif
-
-#define debounce_counter_t uint8_t
-
-static debounce_counter_t *debounce_counters;
+static debounce_counters_t debounce_counters[MATRIX_ROWS];
+static matrix_row_t        locked[MATRIX_ROWS];
 static bool                counters_need_update;
 
-#define DEBOUNCE_ELAPSED 251
-#define MAX_DEBOUNCE (DEBOUNCE_ELAPSED - 1)
-
-void update_debounce_counters(uint8_t num_rows, uint8_t current_time);
-void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t current_time);
-
 // we use num_rows rather than MATRIX_ROWS to support split keyboards
 void debounce_init(uint8_t num_rows) {
-  debounce_counters = (debounce_counter_t *)malloc(num_rows * sizeof(debounce_counter_t));
-  for (uint8_t r = 0; r < num_rows; r++) {
-    debounce_counters[r] = DEBOUNCE_ELAPSED;
-  }
+  counters_reset(debounce_counters, num_rows);
+  memset(locked, 0, sizeof(locked));
+  counters_need_update = false;
 }
 
 void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
-  uint8_t current_time = timer_read() % MAX_DEBOUNCE;
-  bool needed_update = counters_need_update;
-  if (counters_need_update) {
-    update_debounce_counters(num_rows, current_time);
+  if (!changed && !counters_need_update) {
+    return;
   }
 
-  if (changed || (needed_update && !counters_need_update)) {
-    transfer_matrix_values(raw, cooked, num_rows, current_time);
-  }
-}
-
-// If the current time is > debounce counter, set the counter to enable input.
-void update_debounce_counters(uint8_t num_rows, uint8_t current_time) {
-  counters_need_update                 = false;
-  debounce_counter_t *debounce_pointer = debounce_counters;
+  uint8_t elapsed      = debounce_elapsed();
+  counters_need_update = false;
   for (uint8_t row = 0; row < num_rows; row++) {
-    if (*debounce_pointer != DEBOUNCE_ELAPSED) {
-      if (TIMER_DIFF(current_time, *debounce_pointer, MAX_DEBOUNCE) >= DEBOUNCE) {
-        *debounce_pointer = DEBOUNCE_ELAPSED;
-      } else {
-        counters_need_update = true;
+    if (locked[row]) {
+      counters_add(&debounce_counters[row], DEBOUNCE_ROW_ALL, elapsed);
+      if (counters_elapsed(&debounce_counters[row])) {
+        locked[row] = 0;
       }
     }
-    debounce_pointer++;
-  }
-}
 
-// upload from raw_matrix to final matrix;
-void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t current_time) {
-  debounce_counter_t *debounce_pointer = debounce_counters;
-  for (uint8_t row = 0; row < num_rows; row++) {
-    matrix_row_t existing_row = cooked[row];
-    matrix_row_t raw_row      = raw[row];
+    // a row that just unlocked takes any change made in the meantime
+    if (!locked[row] && raw[row] != cooked[row]) {
+      cooked[row] = raw[row];
+      locked[row] = DEBOUNCE_ROW_ALL;
+      counters_clear(&debounce_counters[row], DEBOUNCE_ROW_ALL);
+    }
 
-    // determine new value basd on debounce pointer + raw value
-    if (*debounce_pointer == DEBOUNCE_ELAPSED && (existing_row != raw_row)) {
-      *debounce_pointer    = current_time;
-      cooked[row]          = raw_row;
+    if (locked[row]) {
       counters_need_update = true;
     }
-
-    debounce_pointer++;
   }
 }
 
@@ -0,0 +1,63 @@
+/*
+Copyright 2019 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Symmetric per-key algorithm, using bit-sliced counters.
+A key that differs from its debounced state starts counting. Bouncing back
+to the debounced state resets its counter. Once it has been stable in the
+new state for DEBOUNCE milliseconds, the change is pushed.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include "bitsliced_counters.h"
+
+static debounce_counters_t debounce_counters[MATRIX_ROWS];
+static matrix_row_t        counting[MATRIX_ROWS];
+static bool                counters_need_update;
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+  counters_reset(debounce_counters, num_rows);
+  memset(counting, 0, sizeof(counting));
+  counters_need_update = false;
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+  if (!changed && !counters_need_update) {
+    return;
+  }
+
+  uint8_t elapsed      = debounce_elapsed();
+  counters_need_update = false;
+  for (uint8_t row = 0; row < num_rows; row++) {
+    matrix_row_t delta = raw[row] ^ cooked[row];
+
+    // keys that bounced back start over, keys that kept their state count on
+    counters_clear(&debounce_counters[row], ~delta);
+    counters_add(&debounce_counters[row], counting[row] & delta, elapsed);
+
+    matrix_row_t done = counters_elapsed(&debounce_counters[row]) & delta;
+    counters_clear(&debounce_counters[row], done);
+    cooked[row] ^= done;
+    counting[row] = delta & ~done;
+
+    if (counting[row]) {
+      counters_need_update = true;
+    }
+  }
+}
+
+bool debounce_active(void) { return true; }
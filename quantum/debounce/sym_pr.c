@@ -0,0 +1,72 @@
+/*
+Copyright 2019 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Symmetric per-row algorithm, using bit-sliced counters.
+Any change within a row restarts the counter of that row. When the row has
+not changed for DEBOUNCE milliseconds, the whole row is pushed.
+The row counter is kept in every column of the row, so it shares the
+per-key counter code.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include "bitsliced_counters.h"
+
+static debounce_counters_t debounce_counters[MATRIX_ROWS];
+static matrix_row_t        last_raw[MATRIX_ROWS];
+static matrix_row_t        counting[MATRIX_ROWS];
+static bool                counters_need_update;
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+  counters_reset(debounce_counters, num_rows);
+  memset(last_raw, 0, sizeof(last_raw));
+  memset(counting, 0, sizeof(counting));
+  counters_need_update = false;
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+  if (!changed && !counters_need_update) {
+    return;
+  }
+
+  uint8_t elapsed      = debounce_elapsed();
+  counters_need_update = false;
+  for (uint8_t row = 0; row < num_rows; row++) {
+    matrix_row_t raw_row = raw[row];
+
+    if (raw_row == cooked[row]) {
+      counting[row] = 0;
+    } else if (raw_row != last_raw[row] || !counting[row]) {
+      counting[row] = DEBOUNCE_ROW_ALL;
+      counters_clear(&debounce_counters[row], DEBOUNCE_ROW_ALL);
+    } else {
+      counters_add(&debounce_counters[row], DEBOUNCE_ROW_ALL, elapsed);
+    }
+    last_raw[row] = raw_row;
+
+    if (counting[row]) {
+      if (counters_elapsed(&debounce_counters[row])) {
+        cooked[row]   = raw_row;
+        counting[row] = 0;
+      } else {
+        counters_need_update = true;
+      }
+    }
+  }
+}
+
+bool debounce_active(void) { return true; }
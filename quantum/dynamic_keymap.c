@@ -70,6 +70,7 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
 	// Big endian, so we can read/write EEPROM directly from host if we want
 	eeprom_update_byte(address, (uint8_t)(keycode >> 8));
 	eeprom_update_byte(address+1, (uint8_t)(keycode & 0xFF));
+	layer_cache_invalidate();
 }
 
 void dynamic_keymap_reset(void)
@@ -114,6 +115,7 @@ void dynamic_keymap_set_buffer( uint16_t offset, uint16_t size, uint8_t *data )
 		source++;
 		target++;
 	}
+	layer_cache_invalidate();
 }
 
 // This overrides the one in quantum/keymap_common.c
@@ -213,6 +215,10 @@ void dynamic_keymap_macro_send( uint8_t id )
 	// Send the macro string one or two chars at a time
 	// by making temporary 1 or 2 char strings
 	char data[3] = { 0, 0, 0 };
+#ifdef SEND_STRING_BATCH
+	// Plain chars are batched across the whole macro
+	send_string_batch_begin(SEND_STRING_BATCH_INTERVAL);
+#endif
 	// We already checked there was a null at the end of
 	// the buffer, so this cannot go past the end
 	while ( 1 ) {
@@ -230,8 +236,17 @@ void dynamic_keymap_macro_send( uint8_t id )
 				break;
 			}
 		}
+#ifdef SEND_STRING_BATCH
+		else {
+			send_string_batch_char(data[0]);
+			continue;
+		}
+#endif
 		send_string(data);
 	}
+#ifdef SEND_STRING_BATCH
+	send_string_batch_end();
+#endif
 }
 
 #endif // DYNAMIC_KEYMAP_ENABLE
@@ -24,17 +24,54 @@ __attribute__((weak)) combo_t key_combos[COMBO_COUNT] = {
 __attribute__((weak)) void process_combo_event(uint8_t combo_index,
                                                bool pressed) {}
 
-static uint16_t timer = 0;
+#ifdef COMBO_TERM_PER_COMBO
+__attribute__((weak)) uint16_t get_combo_term(uint8_t combo_index,
+                                              combo_t *combo) {
+  return COMBO_TERM;
+}
+#define COMBO_TERM_FOR(index) get_combo_term((index), &key_combos[(index)])
+#else
+#define COMBO_TERM_FOR(index) COMBO_TERM
+#endif
+
 static uint8_t current_combo_index = 0;
-static bool drop_buffer = false;
-static bool is_active = false;
 
-static uint8_t buffer_size = 0;
+/* Combo keys pressed since the buffer was last resolved, in press order.
+ * They are held back while at least one combo can still match them. */
+typedef struct {
+  uint16_t keycode;
 #ifdef COMBO_ALLOW_ACTION_KEYS
-static keyrecord_t key_buffer[MAX_COMBO_LENGTH];
+  keyrecord_t record;
 #else
-static uint16_t key_buffer[MAX_COMBO_LENGTH];
+  uint16_t time;
 #endif
+} combo_key_t;
+
+#ifdef COMBO_ALLOW_ACTION_KEYS
+#define COMBO_KEY_TIME(k) ((k).record.event.time)
+#else
+#define COMBO_KEY_TIME(k) ((k).time)
+#endif
+
+static uint8_t buffer_size = 0;
+static combo_key_t key_buffer[MAX_COMBO_LENGTH];
+
+/* Longest combo completed by a prefix of the buffer */
+static uint8_t pending_combo = 0;
+static uint8_t pending_size = 0;
+
+/* Keycode index: one entry per (combo, key) pair, sorted by keycode and then
+ * by combo, so an event only visits the combos that contain its keycode. */
+#define COMBO_INDEX_ENTRY(combo, key) (((uint16_t)(combo) << 8) | (key))
+#define COMBO_INDEX_COMBO(entry) ((entry) >> 8)
+#define COMBO_INDEX_KEY(entry) ((entry) & 0xFF)
+
+#if COMBO_INDEX_SIZE > 0
+static uint16_t combo_index[COMBO_INDEX_SIZE];
+#endif
+static uint16_t combo_index_size = 0;
+static bool combo_index_overflow = false;
+static uint8_t combo_length[COMBO_COUNT];
 
 static inline void send_combo(uint16_t action, bool pressed) {
   if (action) {
@@ -48,130 +85,294 @@ static inline void send_combo(uint16_t action, bool pressed) {
   }
 }
 
-static inline void dump_key_buffer(bool emit) {
-  if (buffer_size == 0) {
-    return;
+#if COMBO_INDEX_SIZE > 0
+static inline uint16_t combo_index_keycode(uint16_t entry) {
+  return pgm_read_word(&key_combos[COMBO_INDEX_COMBO(entry)].keys[COMBO_INDEX_KEY(entry)]);
+}
+
+/* Returns the position of the first index entry for keycode */
+static uint16_t combo_index_find(uint16_t keycode) {
+  uint16_t first = 0;
+  uint16_t last = combo_index_size;
+  while (first < last) {
+    uint16_t middle = first + (last - first) / 2;
+    if (combo_index_keycode(combo_index[middle]) < keycode)
+      first = middle + 1;
+    else
+      last = middle;
   }
+  return first;
+}
+#endif
 
-  if (emit) {
-    for (uint8_t i = 0; i < buffer_size; i++) {
-#ifdef COMBO_ALLOW_ACTION_KEYS
-      const action_t action = store_or_get_action(key_buffer[i].event.pressed,
-                                                  key_buffer[i].event.key);
-      process_action(&(key_buffer[i]), action);
-#else
-      register_code16(key_buffer[i]);
-      send_keyboard_report();
+/* Returns the last index of keycode in the combo, or -1 */
+static int8_t combo_key_index(combo_t *combo, uint16_t keycode) {
+  int8_t index = -1;
+  for (uint8_t count = 0;; ++count) {
+    uint16_t key = pgm_read_word(&combo->keys[count]);
+    if (COMBO_END == key)
+      break;
+    if (keycode == key)
+      index = count;
+  }
+  return index;
+}
+
+static void build_combo_index(void) {
+  combo_index_size = 0;
+  combo_index_overflow = false;
+
+  for (uint8_t c = 0; c < COMBO_COUNT; ++c) {
+    const uint16_t *keys = key_combos[c].keys;
+    uint8_t count = 0;
+    while (pgm_read_word(&keys[count]) != COMBO_END)
+      ++count;
+    combo_length[c] = count;
+
+    for (uint8_t k = 0; k < count; ++k) {
+      uint16_t keycode = pgm_read_word(&keys[k]);
+      /* a keycode listed twice only counts at its last position */
+      if (combo_key_index(&key_combos[c], keycode) != k)
+        continue;
+#if COMBO_INDEX_SIZE > 0
+      if (combo_index_size < COMBO_INDEX_SIZE) {
+        /* insertion sort, stable so combos keep their order per keycode */
+        uint16_t i = combo_index_size++;
+        for (; i > 0 && combo_index_keycode(combo_index[i - 1]) > keycode; --i)
+          combo_index[i] = combo_index[i - 1];
+        combo_index[i] = COMBO_INDEX_ENTRY(c, k);
+        continue;
+      }
 #endif
+      combo_index_overflow = true;
     }
   }
 
-  buffer_size = 0;
+  if (combo_index_overflow) {
+    dprintln("COMBO: index full, falling back to a linear scan");
+  }
 }
 
-#define ALL_COMBO_KEYS_ARE_DOWN (((1 << count) - 1) == combo->state)
-#define KEY_STATE_DOWN(key)                                                    \
-  do {                                                                         \
-    combo->state |= (1 << key);                                                \
-  } while (0)
-#define KEY_STATE_UP(key)                                                      \
-  do {                                                                         \
-    combo->state &= ~(1 << key);                                               \
-  } while (0)
+void combo_init(void) { build_combo_index(); }
 
-static bool process_single_combo(combo_t *combo, uint16_t keycode,
-                                 keyrecord_t *record) {
-  uint8_t count = 0;
-  uint8_t index = -1;
-  /* Find index of keycode and number of combo keys */
-  for (const uint16_t *keys = combo->keys;; ++count) {
-    uint16_t key = pgm_read_word(&keys[count]);
-    if (keycode == key)
-      index = count;
-    if (COMBO_END == key)
-      break;
-  }
+void combo_index_invalidate(void) { build_combo_index(); }
 
-  /* Continue processing if not a combo key */
-  if (-1 == (int8_t)index)
+/* Returns the cursor for combo_next_with_key */
+static uint16_t combo_first_with_key(uint16_t keycode) {
+#if COMBO_INDEX_SIZE > 0
+  if (!combo_index_overflow)
+    return combo_index_find(keycode);
+#endif
+  return 0;
+}
+
+/* Moves the cursor to the next combo containing keycode, setting
+ * current_combo_index and the position of keycode within the combo. The
+ * cursor walks the index, or every combo when the index is incomplete. */
+static bool combo_next_with_key(uint16_t keycode, uint16_t *cursor,
+                                int8_t *key_index) {
+#if COMBO_INDEX_SIZE > 0
+  if (!combo_index_overflow) {
+    if (*cursor < combo_index_size &&
+        combo_index_keycode(combo_index[*cursor]) == keycode) {
+      current_combo_index = COMBO_INDEX_COMBO(combo_index[*cursor]);
+      *key_index = COMBO_INDEX_KEY(combo_index[*cursor]);
+      ++*cursor;
+      return true;
+    }
     return false;
+  }
+#endif
+  for (; *cursor < COMBO_COUNT; ++*cursor) {
+    *key_index = combo_key_index(&key_combos[*cursor], keycode);
+    if (*key_index >= 0) {
+      current_combo_index = (*cursor)++;
+      return true;
+    }
+  }
+  return false;
+}
 
-  bool is_combo_active = is_active;
+#define FOREACH_COMBO_WITH_KEY(keycode, key_index)                             \
+  for (uint16_t cursor = combo_first_with_key(keycode);                        \
+       combo_next_with_key((keycode), &cursor, &(key_index));)
 
-  if (record->event.pressed) {
-    KEY_STATE_DOWN(index);
+static bool is_combo_key(uint16_t keycode) {
+  int8_t key_index;
+  FOREACH_COMBO_WITH_KEY(keycode, key_index) { return true; }
+  return false;
+}
 
-    if (is_combo_active) {
-      if (ALL_COMBO_KEYS_ARE_DOWN) { /* Combo was pressed */
-        send_combo(combo->keycode, true);
-        drop_buffer = true;
+/* Event times have their low bit set, so they can be a tick ahead of the timer */
+static inline uint16_t elapsed_since(uint16_t time) {
+  int16_t elapsed = timer_read() - time;
+  return elapsed < 0 ? 0 : elapsed;
+}
+
+/** \brief Evaluate the buffered keys
+ *
+ * Finds the longest combo matching a prefix of the buffer, typed within its
+ * term, and stores it in pending_combo/pending_size. Returns true while some
+ * longer combo containing the whole buffer is still within its term.
+ */
+static bool evaluate_buffer(void) {
+  const uint16_t elapsed = elapsed_since(COMBO_KEY_TIME(key_buffer[0]));
+  const uint16_t first = COMBO_KEY_TIME(key_buffer[0]);
+  bool can_grow = false;
+  int8_t key_index;
+  pending_size = 0;
+
+  for (uint8_t n = 1; n <= buffer_size; ++n) {
+    bool viable = false;
+    can_grow = false;
+
+    FOREACH_COMBO_WITH_KEY(key_buffer[0].keycode, key_index) {
+      combo_t *combo = &key_combos[current_combo_index];
+      uint8_t length = combo_length[current_combo_index];
+      /* keys of a combo that fired are still held */
+      if (combo->state || length < n)
+        continue;
+
+      uint16_t term = COMBO_TERM_FOR(current_combo_index);
+      if (TIMER_DIFF_16(COMBO_KEY_TIME(key_buffer[n - 1]), first) >= term)
+        continue;
+
+      uint8_t k = 1;
+      while (k < n && combo_key_index(combo, key_buffer[k].keycode) >= 0)
+        ++k;
+      if (k < n)
+        continue;
+
+      viable = true;
+      if (length == n) {
+        if (pending_size < n) {
+          pending_combo = current_combo_index;
+          pending_size = n;
+        }
+      } else if (elapsed < term) {
+        can_grow = true;
       }
     }
-  } else {
-    if (ALL_COMBO_KEYS_ARE_DOWN) { /* Combo was released */
-      send_combo(combo->keycode, false);
-    } else {
-      /* continue processing without immediately returning */
-      is_combo_active = false;
-    }
 
-    KEY_STATE_UP(index);
+    if (!viable)
+      return false;
   }
+  return can_grow;
+}
 
-  return is_combo_active;
+static void drop_buffered_keys(uint8_t count) {
+  buffer_size -= count;
+  for (uint8_t i = 0; i < buffer_size; ++i) {
+    key_buffer[i] = key_buffer[i + count];
+  }
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == combo->state)
+static void fire_pending_combo(void) {
+  combo_t *combo = &key_combos[pending_combo];
+  current_combo_index = pending_combo;
 
-bool process_combo(uint16_t keycode, keyrecord_t *record) {
-  bool is_combo_key = false;
-  drop_buffer = false;
-  bool no_combo_keys_pressed = true;
+  /* the combo owns its keys until they are all released */
+  for (uint8_t i = 0; i < pending_size; ++i) {
+    int8_t index = combo_key_index(combo, key_buffer[i].keycode);
+    combo->state |= (1 << index);
+  }
+  combo->active = true;
+  LATENCY_TRACE_BEGIN(combo, COMBO_KEY_TIME(key_buffer[0]));
+  send_combo(combo->keycode, true);
+  LATENCY_TRACE_END(combo);
+
+  drop_buffered_keys(pending_size);
+  pending_size = 0;
+}
+
+static void emit_first_key(void) {
+  LATENCY_TRACE_BEGIN(key, COMBO_KEY_TIME(key_buffer[0]));
+#ifdef COMBO_ALLOW_ACTION_KEYS
+  const action_t action = store_or_get_action(key_buffer[0].record.event.pressed,
+                                              key_buffer[0].record.event.key);
+  process_action(&(key_buffer[0].record), action);
+#else
+  register_code16(key_buffer[0].keycode);
+#endif
+  LATENCY_TRACE_END(key);
+  drop_buffered_keys(1);
+}
+
+/** \brief Resolve the buffer
+ *
+ * Fires the longest matching combo or passes the first key on, until the
+ * rest of the buffer can still grow into a combo. With flush set, the whole
+ * buffer is resolved.
+ */
+static void resolve_buffer(bool flush) {
+  while (buffer_size) {
+    bool wait = evaluate_buffer();
+    if (wait && !flush)
+      break;
+
+    if (pending_size) {
+      fire_pending_combo();
+    } else {
+      emit_first_key();
+    }
+  }
+}
+
+/* Releases the key from any combo that fired with it, returns whether the
+ * release is consumed by a combo */
+static bool release_combo_key(uint16_t keycode) {
+  bool consumed = false;
+  int8_t key_index;
 
-  for (current_combo_index = 0; current_combo_index < COMBO_COUNT;
-       ++current_combo_index) {
+  FOREACH_COMBO_WITH_KEY(keycode, key_index) {
     combo_t *combo = &key_combos[current_combo_index];
-    is_combo_key |= process_single_combo(combo, keycode, record);
-    no_combo_keys_pressed = no_combo_keys_pressed && NO_COMBO_KEYS_ARE_DOWN;
-  }
-
-  if (drop_buffer) {
-    /* buffer is only dropped when we complete a combo, so we refresh the timer
-     * here */
-    timer = timer_read();
-    dump_key_buffer(false);
-  } else if (!is_combo_key) {
-    /* if no combos claim the key we need to emit the keybuffer */
-    dump_key_buffer(true);
-
-    // reset state if there are no combo keys pressed at all
-    if (no_combo_keys_pressed) {
-      timer = 0;
-      is_active = true;
+    if (!(combo->state & (1 << key_index)))
+      continue;
+
+    consumed = true;
+    if (combo->active) {
+      /* the first key released ends the combo */
+      combo->active = false;
+      send_combo(combo->keycode, false);
     }
-  } else if (record->event.pressed && is_active) {
-    /* otherwise the key is consumed and placed in the buffer */
-    timer = timer_read();
+    combo->state &= ~(1 << key_index);
+  }
+  return consumed;
+}
+
+bool process_combo(uint16_t keycode, keyrecord_t *record) {
+  if (!is_combo_key(keycode)) {
+    /* any other key ends the buffer, so it is emitted in order */
+    resolve_buffer(true);
+    return true;
+  }
 
-    if (buffer_size < MAX_COMBO_LENGTH) {
+  if (record->event.pressed) {
+    if (buffer_size == MAX_COMBO_LENGTH) {
+      resolve_buffer(true);
+    }
 #ifdef COMBO_ALLOW_ACTION_KEYS
-      key_buffer[buffer_size++] = *record;
+    key_buffer[buffer_size++] = (combo_key_t){.keycode = keycode, .record = *record};
 #else
-      key_buffer[buffer_size++] = keycode;
+    key_buffer[buffer_size++] = (combo_key_t){.keycode = keycode, .time = record->event.time};
 #endif
-    }
+    resolve_buffer(false);
+    return false;
   }
 
-  return !is_combo_key;
+  for (uint8_t i = 0; i < buffer_size; ++i) {
+    if (key_buffer[i].keycode == keycode) {
+      /* a buffered key was let go before any combo could complete */
+      resolve_buffer(true);
+      break;
+    }
+  }
+  return !release_combo_key(keycode);
 }
 
 void matrix_scan_combo(void) {
-  if (is_active && timer && timer_elapsed(timer) > COMBO_TERM) {
-
-    /* This disables the combo, meaning key events for this
-     * combo will be handled by the next processors in the chain
-     */
-    is_active = false;
-    dump_key_buffer(true);
+  if (buffer_size) {
+    /* lets keys through as soon as the terms of all candidates ran out */
+    resolve_buffer(false);
   }
 }
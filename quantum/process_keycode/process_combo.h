@@ -39,6 +39,7 @@ typedef struct {
 #else
   uint8_t state;
 #endif
+  bool active;
 } combo_t;
 
 #define COMBO(ck, ca)                                                          \
@@ -53,9 +54,20 @@ typedef struct {
 #ifndef COMBO_TERM
 #define COMBO_TERM TAPPING_TERM
 #endif
+/* Number of (combo, key) pairs the keycode index can hold, combos beyond it
+ * make process_combo fall back to scanning every combo */
+#ifndef COMBO_INDEX_SIZE
+#define COMBO_INDEX_SIZE (COMBO_COUNT * 3)
+#endif
 
+void combo_init(void);
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void matrix_scan_combo(void);
 void process_combo_event(uint8_t combo_index, bool pressed);
+#ifdef COMBO_TERM_PER_COMBO
+uint16_t get_combo_term(uint8_t combo_index, combo_t *combo);
+#endif
+/* call after changing the keys of a combo in key_combos at runtime */
+void combo_index_invalidate(void);
 
 #endif
@@ -102,10 +102,12 @@ static inline void process_tap_dance_action_on_dance_finished (qk_tap_dance_acti
   if (action->state.finished)
     return;
   action->state.finished = true;
+  LATENCY_TRACE_BEGIN(dance, action->state.timer | 1);
   add_mods(action->state.oneshot_mods);
   add_weak_mods(action->state.weak_mods);
   send_keyboard_report();
   _process_tap_dance_action_fn (&action->state, action->user_data, action->fn.on_dance_finished);
+  LATENCY_TRACE_END(dance);
 }
 
 static inline void process_tap_dance_action_on_reset (qk_tap_dance_action_t *action)
@@ -99,6 +99,7 @@ void unicode_input_start(void) {
     break;
   }
 
+  host_keyboard_flush();
   wait_ms(UNICODE_TYPE_DELAY);
 }
 
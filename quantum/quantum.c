@@ -143,6 +143,7 @@ void unregister_code16 (uint16_t code) {
 void tap_code16(uint16_t code) {
   register_code16(code);
   #if TAP_CODE_DELAY > 0
+    host_keyboard_flush();
     wait_ms(TAP_CODE_DELAY);
   #endif
   unregister_code16(code);
@@ -774,11 +775,19 @@ const uint8_t ascii_to_keycode_lut[0x80] PROGMEM = {
 };
 
 void send_string(const char *str) {
+#ifdef SEND_STRING_BATCH
+  send_string_batched(str);
+#else
   send_string_with_delay(str, 0);
+#endif
 }
 
 void send_string_P(const char *str) {
+#ifdef SEND_STRING_BATCH
+  send_string_batched_P(str);
+#else
   send_string_with_delay_P(str, 0);
+#endif
 }
 
 void send_string_with_delay(const char *str, uint8_t interval) {
@@ -803,6 +812,9 @@ void send_string_with_delay(const char *str, uint8_t interval) {
         }
         ++str;
         // interval
+        if (interval) {
+            host_keyboard_flush();
+        }
         { uint8_t ms = interval; while (ms--) wait_ms(1); }
     }
 }
@@ -829,6 +841,9 @@ void send_string_with_delay_P(const char *str, uint8_t interval) {
         }
         ++str;
         // interval
+        if (interval) {
+            host_keyboard_flush();
+        }
         { uint8_t ms = interval; while (ms--) wait_ms(1); }
     }
 }
@@ -853,6 +868,183 @@ void send_char(char ascii_code) {
   }
 }
 
+/* Batched send_string
+ *
+ * Characters are planned into groups that share one press report. A group
+ * holds consecutive characters that need the same modifiers and whose
+ * keycodes go strictly up, so the host reads them back in the order they
+ * were typed whether it walks the report in slot order or in keycode order.
+ * The press report of a group also releases the previous group, unless the
+ * two share a key or need different modifiers; then a release report goes
+ * out first. The modifiers are sent as weak mods, so keys held with SS_DOWN()
+ * still apply.
+ */
+static uint8_t batch_interval;
+static uint8_t batch_mods;
+static uint8_t batch_count;
+static uint8_t batch_keys[SEND_STRING_BATCH_KEYS];
+static uint8_t batch_held_mods;
+static uint8_t batch_held_count;
+static uint8_t batch_held[SEND_STRING_BATCH_KEYS];
+
+static void send_string_batch_wait(void) {
+  if (batch_interval) {
+    host_keyboard_flush();
+  }
+  { uint8_t ms = batch_interval; while (ms--) wait_ms(1); }
+}
+
+static void send_string_batch_report(void) {
+  send_keyboard_report();
+  send_string_batch_wait();
+}
+
+// How many keys one group may press, leaving room for keys held outside the batch
+static uint8_t send_string_batch_limit(void) {
+#ifdef NKRO_ENABLE
+  if (keyboard_protocol && keymap_config.nkro) {
+    return SEND_STRING_BATCH_KEYS;
+  }
+#endif
+  uint8_t others = has_anykey(keyboard_report) - batch_held_count;
+  uint8_t limit = others < KEYBOARD_REPORT_KEYS ? KEYBOARD_REPORT_KEYS - others : 1;
+  return limit < SEND_STRING_BATCH_KEYS ? limit : SEND_STRING_BATCH_KEYS;
+}
+
+static void send_string_batch_emit(void) {
+  if (!batch_count) {
+    return;
+  }
+  bool release = batch_mods != batch_held_mods;
+  for (uint8_t i = 0; i < batch_count && !release; i++) {
+    for (uint8_t j = 0; j < batch_held_count; j++) {
+      if (batch_keys[i] == batch_held[j]) {
+        release = true;
+        break;
+      }
+    }
+  }
+  for (uint8_t j = 0; j < batch_held_count; j++) {
+    del_key(batch_held[j]);
+  }
+  if (release) {
+    del_weak_mods(batch_held_mods);
+    add_weak_mods(batch_mods);
+    batch_held_mods = batch_mods;
+    send_string_batch_report();
+  }
+  for (uint8_t i = 0; i < batch_count; i++) {
+    add_key(batch_keys[i]);
+    batch_held[i] = batch_keys[i];
+  }
+  batch_held_count = batch_count;
+  batch_count = 0;
+  send_string_batch_report();
+}
+
+/** \brief Starts a batch
+ *
+ * Ends any batch still open, then waits interval milliseconds after every
+ * report of the new one.
+ */
+void send_string_batch_begin(uint8_t interval) {
+  send_string_batch_end();
+  batch_interval = interval;
+}
+
+/** \brief Adds a character to the batch
+ *
+ * The character is sent once its group is complete, at the latest by send_string_batch_end().
+ */
+void send_string_batch_char(char ascii_code) {
+  uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+  if (!keycode) {
+    return;
+  }
+  uint8_t mods = 0;
+  if (pgm_read_byte(&ascii_to_shift_lut[(uint8_t)ascii_code])) {
+    mods |= MOD_BIT(KC_LSFT);
+  }
+  if (pgm_read_byte(&ascii_to_altgr_lut[(uint8_t)ascii_code])) {
+    mods |= MOD_BIT(KC_RALT);
+  }
+  if (batch_count && (mods != batch_mods || keycode <= batch_keys[batch_count - 1] || batch_count >= send_string_batch_limit())) {
+    send_string_batch_emit();
+  }
+  batch_mods = mods;
+  batch_keys[batch_count++] = keycode;
+}
+
+/** \brief Sends what is left of the batch and releases its keys and modifiers
+ */
+void send_string_batch_end(void) {
+  send_string_batch_emit();
+  if (!batch_held_count && !batch_held_mods) {
+    return;
+  }
+  for (uint8_t j = 0; j < batch_held_count; j++) {
+    del_key(batch_held[j]);
+  }
+  del_weak_mods(batch_held_mods);
+  batch_held_count = 0;
+  batch_held_mods = 0;
+  send_string_batch_report();
+}
+
+static void send_string_batch_code(uint8_t code, uint8_t keycode) {
+  send_string_batch_end();
+  if (code != SS_UP_CODE) {
+    register_code(keycode);
+  }
+  if (code != SS_DOWN_CODE) {
+    unregister_code(keycode);
+  }
+  send_string_batch_wait();
+}
+
+void send_string_batched(const char *str) {
+  send_string_batched_with_delay(str, SEND_STRING_BATCH_INTERVAL);
+}
+
+void send_string_batched_P(const char *str) {
+  send_string_batched_with_delay_P(str, SEND_STRING_BATCH_INTERVAL);
+}
+
+/** \brief Types a string in as few reports as possible
+ *
+ * Like send_string_with_delay(), but interval is waited after every report
+ * rather than after every character.
+ */
+void send_string_batched_with_delay(const char *str, uint8_t interval) {
+  send_string_batch_begin(interval);
+  while (1) {
+    char ascii_code = *str;
+    if (!ascii_code) break;
+    if (ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE) {
+      send_string_batch_code(ascii_code, *(++str));
+    } else {
+      send_string_batch_char(ascii_code);
+    }
+    ++str;
+  }
+  send_string_batch_end();
+}
+
+void send_string_batched_with_delay_P(const char *str, uint8_t interval) {
+  send_string_batch_begin(interval);
+  while (1) {
+    char ascii_code = pgm_read_byte(str);
+    if (!ascii_code) break;
+    if (ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE) {
+      send_string_batch_code(ascii_code, pgm_read_byte(++str));
+    } else {
+      send_string_batch_char(ascii_code);
+    }
+    ++str;
+  }
+  send_string_batch_end();
+}
+
 void set_single_persistent_default_layer(uint8_t default_layer) {
   #if defined(AUDIO_ENABLE) && defined(DEFAULT_LAYER_SONGS)
     PLAY_SONG(default_layer_songs[default_layer]);
@@ -970,6 +1162,9 @@ void matrix_init_quantum() {
   #ifdef OUTPUT_AUTO_ENABLE
     set_output(OUTPUT_AUTO);
   #endif
+  #ifdef COMBO_ENABLE
+    combo_init();
+  #endif
   matrix_init_kb();
 }
 
@@ -995,7 +1190,9 @@ void matrix_scan_quantum() {
   #endif
 
   #ifdef RGB_MATRIX_ENABLE
+    SCAN_PROFILE_BEGIN(PROFILE_RGB_MATRIX);
     rgb_matrix_task();
+    SCAN_PROFILE_END(PROFILE_RGB_MATRIX);
   #endif
 
   #ifdef ENCODER_ENABLE
@@ -60,6 +60,8 @@
 #include "print.h"
 #include "send_string_keycodes.h"
 #include "suspend.h"
+#include "scan_profile.h"
+#include "latency_trace.h"
 
 extern uint32_t default_layer_state;
 
@@ -222,6 +224,22 @@ void send_string_P(const char *str);
 void send_string_with_delay_P(const char *str, uint8_t interval);
 void send_char(char ascii_code);
 
+#ifndef SEND_STRING_BATCH_KEYS
+#  define SEND_STRING_BATCH_KEYS 16
+#endif
+#ifndef SEND_STRING_BATCH_INTERVAL
+#  define SEND_STRING_BATCH_INTERVAL 0
+#endif
+
+#define SEND_STRING_BATCHED(str) send_string_batched_P(PSTR(str))
+void send_string_batched(const char *str);
+void send_string_batched_with_delay(const char *str, uint8_t interval);
+void send_string_batched_P(const char *str);
+void send_string_batched_with_delay_P(const char *str, uint8_t interval);
+void send_string_batch_begin(uint8_t interval);
+void send_string_batch_char(char ascii_code);
+void send_string_batch_end(void);
+
 // For tri-layer
 void update_tri_layer(uint8_t layer1, uint8_t layer2, uint8_t layer3);
 uint32_t update_tri_layer_state(uint32_t state, uint8_t layer1, uint8_t layer2, uint8_t layer3);
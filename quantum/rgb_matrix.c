@@ -77,6 +77,14 @@
   #define RGB_MATRIX_SPD_STEP 16
 #endif
 
+// LEDs rendered per rgb_matrix_task() call. With RGB_MATRIX_RENDER_BUDGET this is
+// only the first guess, later chunks are sized from the measured cost.
+#if RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+  #define RGB_MATRIX_RENDER_CHUNK (RGB_MATRIX_LED_PROCESS_LIMIT)
+#else
+  #define RGB_MATRIX_RENDER_CHUNK DRIVER_LED_TOTAL
+#endif
+
 #if !defined(RGB_MATRIX_STARTUP_MODE)
   #ifndef DISABLE_RGB_MATRIX_CYCLE_ALL
     #define RGB_MATRIX_STARTUP_MODE RGB_MATRIX_CYCLE_LEFT_RIGHT
@@ -243,6 +251,13 @@ static uint8_t rgb_last_enable = UINT8_MAX;
 static uint8_t rgb_last_effect = UINT8_MAX;
 static effect_params_t rgb_effect_params = { 0, 0xFF };
 static rgb_task_states rgb_task_state = SYNCING;
+static uint8_t rgb_render_chunk = RGB_MATRIX_RENDER_CHUNK;
+static uint32_t rgb_frame_start;
+static uint32_t rgb_frame_us;
+#ifdef RGB_MATRIX_RENDER_BUDGET
+// Render cost of one LED in 1/16 us
+static uint16_t rgb_render_cost;
+#endif
 
 static void rgb_task_timers(void) {
   // Update double buffer timers
@@ -278,6 +293,8 @@ static void rgb_task_sync(void) {
 static void rgb_task_start(void) {
   // reset iter
   rgb_effect_params.iter = 0;
+  rgb_effect_params.led_min = 0;
+  rgb_frame_start = timer_read_ticks();
 
   // update double buffers
   g_rgb_counters.tick = rgb_counters_buffer;
@@ -289,9 +306,41 @@ static void rgb_task_start(void) {
   rgb_task_state = RENDERING;
 }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET
+// Sizes the next chunk from what the last one cost. The cost goes up at once,
+// so a chunk that ran over is followed by a smaller one, but comes down only a
+// quarter of the way each time, so one cheap chunk doesn't lead to an oversized next one.
+static void rgb_task_budget(uint32_t start_ticks) {
+  uint8_t led_max = rgb_effect_params.led_max > DRIVER_LED_TOTAL ? DRIVER_LED_TOTAL : rgb_effect_params.led_max;
+  uint8_t leds = led_max > rgb_effect_params.led_min ? led_max - rgb_effect_params.led_min : 1;
+  uint32_t cost = (timer_elapsed_us(start_ticks) << 4) / leds;
+  if (cost > UINT16_MAX) {
+    cost = UINT16_MAX;
+  }
+  if (cost >= rgb_render_cost) {
+    rgb_render_cost = cost;
+  } else {
+    rgb_render_cost -= (rgb_render_cost - cost + 3) >> 2;
+  }
+
+  uint32_t chunk = rgb_render_cost ? ((uint32_t)RGB_MATRIX_RENDER_BUDGET << 4) / rgb_render_cost : DRIVER_LED_TOTAL;
+  if (chunk < 1) {
+    chunk = 1;
+  } else if (chunk > DRIVER_LED_TOTAL) {
+    chunk = DRIVER_LED_TOTAL;
+  }
+  rgb_render_chunk = chunk;
+}
+#endif
+
 static void rgb_task_render(uint8_t effect) {
   bool rendering = false;
   rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
+  uint16_t led_max = rgb_effect_params.led_min + rgb_render_chunk;
+  rgb_effect_params.led_max = led_max > UINT8_MAX ? UINT8_MAX : led_max;
+#ifdef RGB_MATRIX_RENDER_BUDGET
+  uint32_t start_ticks = timer_read_ticks();
+#endif
 
   // each effect can opt to do calculations
   // and/or request PWM buffer updates.
@@ -333,7 +382,11 @@ static void rgb_task_render(uint8_t effect) {
       return;
   }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET
+  rgb_task_budget(start_ticks);
+#endif
   rgb_effect_params.iter++;
+  rgb_effect_params.led_min = rgb_effect_params.led_max;
 
   // next task
   if (!rendering) {
@@ -352,6 +405,7 @@ static void rgb_task_flush(uint8_t effect) {
 
   // update pwm buffers
   rgb_matrix_update_pwm_buffers();
+  rgb_frame_us = timer_elapsed_us(rgb_frame_start);
 
   // next task
   rgb_task_state = SYNCING;
@@ -541,6 +595,16 @@ uint8_t rgb_matrix_get_mode(void) {
   return rgb_matrix_config.mode;
 }
 
+// Microseconds from the start of the last frame until it was flushed
+uint32_t rgb_matrix_get_frame_us(void) {
+  return rgb_frame_us;
+}
+
+// LEDs rendered per rgb_matrix_task() call
+uint8_t rgb_matrix_get_render_chunk(void) {
+  return rgb_render_chunk;
+}
+
 void rgb_matrix_sethsv(uint16_t hue, uint8_t sat, uint8_t val) {
   rgb_matrix_sethsv_noeeprom(hue, sat, val);
   eeconfig_update_rgb_matrix(rgb_matrix_config.raw);
@@ -44,15 +44,10 @@
   #define RGB_MATRIX_LED_PROCESS_LIMIT (DRIVER_LED_TOTAL + 4) / 5
 #endif
 
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
-#define RGB_MATRIX_USE_LIMITS(min, max) uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter; \
-  uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT; \
+#define RGB_MATRIX_USE_LIMITS(min, max) uint8_t min = params->led_min; \
+  uint8_t max = params->led_max; \
   if (max > DRIVER_LED_TOTAL) \
     max = DRIVER_LED_TOTAL;
-#else
-#define RGB_MATRIX_USE_LIMITS(min, max) uint8_t min = 0; \
-  uint8_t max = DRIVER_LED_TOTAL;
-#endif
 
 #define RGB_MATRIX_TEST_LED_FLAGS() if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
 
@@ -144,6 +139,8 @@ void rgb_matrix_set_flags(led_flags_t flags);
 void rgb_matrix_mode(uint8_t mode);
 void rgb_matrix_mode_noeeprom(uint8_t mode);
 uint8_t rgb_matrix_get_mode(void);
+uint32_t rgb_matrix_get_frame_us(void);
+uint8_t rgb_matrix_get_render_chunk(void);
 
 #ifndef RGBLIGHT_ENABLE
 #define rgblight_toggle() rgb_matrix_toggle()
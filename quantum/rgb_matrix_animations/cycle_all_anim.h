@@ -7,9 +7,9 @@ bool CYCLE_ALL(effect_params_t* params) {
 
   HSV hsv = { 0, rgb_matrix_config.sat, rgb_matrix_config.val };
   hsv.h = scale16by8(g_rgb_counters.tick, rgb_matrix_config.speed / 4);
+  RGB rgb = hsv_to_rgb(hsv);
   for (uint8_t i = led_min; i < led_max; i++) {
     RGB_MATRIX_TEST_LED_FLAGS();
-    RGB rgb = hsv_to_rgb(hsv);
     rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
   }
   return led_max < DRIVER_LED_TOTAL;
@@ -0,0 +1,25 @@
+#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && defined(RGB_MATRIX_CUSTOM_EFFECT_IMPLS)
+
+// Shared by the effects that spread out from the last key hits. A render call
+// looks at every hit for every LED, so whatever doesn't depend on the LED is
+// worked out once per call here instead.
+
+// Scales the ticks of the hits from start to count by the effect speed
+static inline void rgb_matrix_scale_hit_ticks(uint16_t* ticks, uint8_t start, uint8_t count) {
+  for (uint8_t j = start; j < count; j++) {
+    ticks[j] = scale16by8(g_last_hit_tracker.tick[j], rgb_matrix_config.speed);
+  }
+}
+
+// Distance of LED i from hit j
+static inline uint8_t rgb_matrix_hit_distance(uint8_t i, uint8_t j) {
+  int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+  int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+  return sqrt16(dx * dx + dy * dy);
+}
+
+// A scaled tick at which a wave moving out from the hit has passed every LED,
+// no distance is larger than 255
+#define RGB_MATRIX_HIT_PASSED 511
+
+#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && defined(RGB_MATRIX_CUSTOM_EFFECT_IMPLS)
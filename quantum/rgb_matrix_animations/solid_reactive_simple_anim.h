@@ -1,4 +1,3 @@
-#pragma once
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 #ifndef DISABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
 RGB_MATRIX_EFFECT(SOLID_REACTIVE_SIMPLE)
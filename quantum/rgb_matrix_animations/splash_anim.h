@@ -17,17 +17,19 @@ static bool rgb_matrix_multisplash_range(uint8_t start, effect_params_t* params)
 
   HSV hsv = { 0, rgb_matrix_config.sat, 0 };
   uint8_t count = g_last_hit_tracker.count;
+  uint16_t ticks[LED_HITS_TO_REMEMBER];
+  rgb_matrix_scale_hit_ticks(ticks, start, count);
   for (uint8_t i = led_min; i < led_max; i++) {
     RGB_MATRIX_TEST_LED_FLAGS();
     hsv.h = rgb_matrix_config.hue;
     hsv.v = 0;
     for (uint8_t j = start; j < count; j++) {
-      int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-      int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-      uint8_t dist = sqrt16(dx * dx + dy * dy);
-      uint16_t effect = scale16by8(g_last_hit_tracker.tick[j], rgb_matrix_config.speed) - dist;
-      if (effect > 255)
-        effect = 255;
+      uint16_t effect = 255;
+      if (ticks[j] < RGB_MATRIX_HIT_PASSED) {
+        effect = ticks[j] - rgb_matrix_hit_distance(i, j);
+        if (effect > 255)
+          effect = 255;
+      }
       hsv.h += effect;
       hsv.v = qadd8(hsv.v, 255 - effect);
     }
@@ -35,8 +35,8 @@ void process_rgb_matrix_typing_heatmap(keyrecord_t *record) {
 
 bool TYPING_HEATMAP(effect_params_t* params) {
   // Modified version of RGB_MATRIX_USE_LIMITS to work off of matrix row / col size
-  uint8_t led_min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter;
-  uint8_t led_max = led_min + RGB_MATRIX_LED_PROCESS_LIMIT;
+  uint8_t led_min = params->led_min;
+  uint8_t led_max = params->led_max;
   if (led_max > sizeof(rgb_frame_buffer))
     led_max = sizeof(rgb_frame_buffer);
 
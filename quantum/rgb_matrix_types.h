@@ -45,6 +45,9 @@ typedef struct PACKED {
   uint8_t iter;
   led_flags_t flags;
   bool init;
+  // LEDs to render in this call, led_max is not capped to DRIVER_LED_TOTAL
+  uint8_t led_min;
+  uint8_t led_max;
 } effect_params_t;
 
 typedef struct PACKED {
@@ -27,7 +27,9 @@ SOFTWARE.
 
 #include <stdint.h>
 
+#ifndef MAX_FRAME_SIZE
 #define MAX_FRAME_SIZE 1024
+#endif
 #define NUM_LINKS 2
 
 void init_byte_stuffer(void);
@@ -28,7 +28,9 @@ SOFTWARE.
 #include "serial_link/protocol/triple_buffered_object.h"
 #include "serial_link/system/serial_link.h"
 
+#ifndef NUM_SLAVES
 #define NUM_SLAVES 8
+#endif
 #define LOCAL_OBJECT_EXTRA 16
 
 // master -> slave = 1 local(target all), 1 remote object
@@ -50,10 +50,10 @@ void signal_data_written(void);
 
 #else
 
-inline void serial_link_lock(void) {
+static inline void serial_link_lock(void) {
 }
 
-inline void serial_link_unlock(void) {
+static inline void serial_link_unlock(void) {
 }
 
 void signal_data_written(void);
@@ -188,6 +188,26 @@ static bool read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row)
   return (last_row_value != current_matrix[current_row]);
 }
 
+#  ifdef MATRIX_SKIP_IDLE_SCAN
+static bool matrix_activity(void) {
+  bool active = false;
+
+  // Select every row at once, any pressed key pulls its col low
+  for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+    select_row(x);
+  }
+  wait_us(30);
+
+  for (uint8_t col_index = 0; col_index < MATRIX_COLS && !active; col_index++) {
+    active = !readPin(col_pins[col_index]);
+  }
+
+  unselect_rows();
+
+  return active;
+}
+#  endif
+
 #elif (DIODE_DIRECTION == ROW2COL)
 
 static void select_col(uint8_t col) {
@@ -243,8 +263,43 @@ static bool read_rows_on_col(matrix_row_t current_matrix[], uint8_t current_col)
   return matrix_changed;
 }
 
+#  ifdef MATRIX_SKIP_IDLE_SCAN
+static bool matrix_activity(void) {
+  bool active = false;
+
+  // Select every col at once, any pressed key pulls its row low
+  for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+    select_col(x);
+  }
+  wait_us(30);
+
+  for (uint8_t row_index = 0; row_index < ROWS_PER_HAND && !active; row_index++) {
+    active = !readPin(row_pins[row_index]);
+  }
+
+  unselect_cols();
+
+  return active;
+}
+#  endif
+
 #endif
 
+// Whether the full scan can find a change.
+// With no key down before and none down now, it can't.
+static bool matrix_scan_needed(void) {
+#if defined(MATRIX_SKIP_IDLE_SCAN) && !defined(DIRECT_PINS)
+  for (uint8_t i = 0; i < ROWS_PER_HAND; i++) {
+    if (raw_matrix[i]) {
+      return true;
+    }
+  }
+  return matrix_activity();
+#else
+  return true;
+#endif
+}
+
 void matrix_init(void) {
   debug_enable = true;
   debug_matrix = true;
@@ -285,17 +340,19 @@ void matrix_init(void) {
 uint8_t _matrix_scan(void) {
   bool changed = false;
 
+  if (matrix_scan_needed()) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
-  // Set row, read cols
-  for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
-    changed |= read_cols_on_row(raw_matrix, current_row);
-  }
+    // Set row, read cols
+    for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
+      changed |= read_cols_on_row(raw_matrix, current_row);
+    }
 #elif (DIODE_DIRECTION == ROW2COL)
-  // Set col, read rows
-  for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++) {
-    changed |= read_rows_on_col(raw_matrix, current_col);
-  }
+    // Set col, read rows
+    for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++) {
+      changed |= read_rows_on_col(raw_matrix, current_col);
+    }
 #endif
+  }
 
   debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed);
 
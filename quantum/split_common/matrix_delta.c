@@ -0,0 +1,170 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "matrix_delta.h"
+
+void split_pack_rows(uint8_t *packed, const matrix_row_t rows[], uint8_t count) {
+  for (uint8_t r = 0; r < count; r++) {
+    matrix_row_t row = rows[r];
+    for (uint8_t b = 0; b < SPLIT_ROW_BYTES; b++) {
+      *packed++ = (uint8_t)row;
+      row >>= 8;
+    }
+  }
+}
+
+void split_unpack_rows(matrix_row_t rows[], const uint8_t *packed, uint8_t count) {
+  for (uint8_t r = 0; r < count; r++) {
+    matrix_row_t row = 0;
+    for (uint8_t b = 0; b < SPLIT_ROW_BYTES; b++) {
+      row |= (matrix_row_t)packed[b] << (b * 8);
+    }
+    rows[r] = row;
+    packed += SPLIT_ROW_BYTES;
+  }
+}
+
+// CRC-8 with the polynomial x^8 + x^2 + x + 1
+uint8_t split_crc8(const uint8_t *data, uint8_t length, uint8_t crc) {
+  while (length--) {
+    crc ^= *data++;
+    for (uint8_t i = 0; i < 8; i++) {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+static uint8_t matrix_checksum(uint8_t generation, const matrix_row_t matrix[]) {
+  uint8_t packed[ROWS_PER_HAND * SPLIT_ROW_BYTES];
+  split_pack_rows(packed, matrix, ROWS_PER_HAND);
+  return split_crc8(packed, sizeof(packed), split_crc8(&generation, 1, 0));
+}
+
+void split_delta_slave_init(split_delta_slave_t *slave) {
+  memset(slave, 0, sizeof(*slave));
+}
+
+uint8_t split_delta_slave_update(split_delta_slave_t *slave, const matrix_row_t matrix[], const split_delta_ack_t *ack, split_delta_msg_t *msg) {
+  if (memcmp(slave->matrix, matrix, sizeof(slave->matrix)) != 0) {
+    memcpy(slave->matrix, matrix, sizeof(slave->matrix));
+    slave->generation++;
+    if (slave->generation == slave->base_generation) {
+      // Wrapped around without an acknowledgement, a delta would look like a
+      // full copy and the old acknowledgement like one of this state
+      slave->wrapped = true;
+    }
+  }
+
+  if (slave->wrapped && ack->generation != slave->base_generation) {
+    slave->wrapped = false;
+  }
+
+  if (slave->wrapped || ack->resync) {
+    slave->synced = false;
+  } else if (ack->generation == slave->generation) {
+    memcpy(slave->base, slave->matrix, sizeof(slave->base));
+    slave->base_generation = slave->generation;
+    slave->synced          = true;
+  } else if (ack->generation != slave->base_generation) {
+    // The master holds a state that is no longer known here
+    slave->synced = false;
+  }
+
+  msg->generation = slave->generation;
+  if (slave->synced && slave->base_generation == slave->generation) {
+    return SPLIT_DELTA_UNCHANGED_SIZE;
+  }
+
+  msg->base     = slave->synced ? slave->base_generation : slave->generation;
+  msg->checksum = matrix_checksum(slave->generation, slave->matrix);
+
+  uint8_t *map  = msg->data;
+  uint8_t *rows = msg->data + SPLIT_ROW_MAP_BYTES;
+  memset(map, 0, SPLIT_ROW_MAP_BYTES);
+  for (uint8_t r = 0; r < ROWS_PER_HAND; r++) {
+    if (!slave->synced || slave->matrix[r] != slave->base[r]) {
+      map[r / 8] |= 1 << (r % 8);
+      split_pack_rows(rows, &slave->matrix[r], 1);
+      rows += SPLIT_ROW_BYTES;
+    }
+  }
+  return rows - (uint8_t *)msg;
+}
+
+void split_delta_master_init(split_delta_master_t *master, split_delta_ack_t *ack) {
+  memset(master, 0, sizeof(*master));
+  ack->generation = 0;
+  ack->resync     = 1;
+}
+
+static bool apply_rows(split_delta_master_t *master, const split_delta_msg_t *msg, uint8_t size, bool full) {
+  matrix_row_t   matrix[ROWS_PER_HAND];
+  const uint8_t *map  = msg->data;
+  const uint8_t *rows = msg->data + SPLIT_ROW_MAP_BYTES;
+  const uint8_t *end  = (const uint8_t *)msg + size;
+
+  memcpy(matrix, master->matrix, sizeof(matrix));
+  for (uint8_t r = 0; r < ROWS_PER_HAND; r++) {
+    if (map[r / 8] & (1 << (r % 8))) {
+      if (rows + SPLIT_ROW_BYTES > end) {
+        return false;
+      }
+      split_unpack_rows(&matrix[r], rows, 1);
+      rows += SPLIT_ROW_BYTES;
+    } else if (full) {
+      return false;
+    }
+  }
+  if (rows != end || matrix_checksum(msg->generation, matrix) != msg->checksum) {
+    return false;
+  }
+
+  memcpy(master->matrix, matrix, sizeof(master->matrix));
+  master->generation = msg->generation;
+  master->synced     = true;
+  if (full) {
+    master->updates = 0;
+  }
+  return true;
+}
+
+bool split_delta_master_apply(split_delta_master_t *master, const split_delta_msg_t *msg, uint8_t size, split_delta_ack_t *ack) {
+  bool ok = false;
+
+  if (size == SPLIT_DELTA_UNCHANGED_SIZE) {
+    ok = master->synced && msg->generation == master->generation;
+  } else if (size >= offsetof(split_delta_msg_t, data) + SPLIT_ROW_MAP_BYTES && size <= sizeof(split_delta_msg_t)) {
+    bool full = msg->base == msg->generation;
+    if (!full && master->synced && msg->generation == master->generation) {
+      // Already applied, the acknowledgement has not reached the slave yet
+      ok = matrix_checksum(master->generation, master->matrix) == msg->checksum;
+    } else if (full || (master->synced && msg->base == master->generation)) {
+      ok = apply_rows(master, msg, size, full);
+    }
+  }
+
+  if (!ok) {
+    master->synced = false;
+  } else if (master->updates < SPLIT_TRANSPORT_RESYNC_INTERVAL) {
+    master->updates++;
+  }
+  ack->generation = master->generation;
+  ack->resync     = !master->synced || master->updates >= SPLIT_TRANSPORT_RESYNC_INTERVAL;
+  return ok;
+}
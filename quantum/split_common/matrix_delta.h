@@ -0,0 +1,105 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Change-only encoding of the slave half of the matrix.
+ *
+ * The slave numbers the states of its matrix with a generation counter and
+ * the master acknowledges the generation it holds. While nothing changes the
+ * slave only sends the generation. After a change it sends a map of the rows
+ * that differ from the acknowledged state, those rows, and a CRC-8 over the
+ * generation and its whole matrix. The master checks the CRC after applying
+ * the rows and asks for a full copy whenever it does not match, whenever the
+ * changes are relative to a state it does not hold, and every
+ * SPLIT_TRANSPORT_RESYNC_INTERVAL updates.
+ *
+ * Rows are packed into (MATRIX_COLS + 7) / 8 bytes, least significant first.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matrix.h"
+
+#ifndef ROWS_PER_HAND
+#  define ROWS_PER_HAND (MATRIX_ROWS / 2)
+#endif
+
+#define SPLIT_ROW_BYTES ((MATRIX_COLS + 7) / 8)
+#define SPLIT_ROW_MAP_BYTES ((ROWS_PER_HAND + 7) / 8)
+
+#ifndef SPLIT_TRANSPORT_RESYNC_INTERVAL
+#  define SPLIT_TRANSPORT_RESYNC_INTERVAL 1000
+#endif
+
+// Slave to master
+typedef struct {
+  // Counts the changes of the slave matrix
+  uint8_t generation;
+  // The rest is only sent after a change
+  // Generation the rows apply to, equal to generation for a full copy
+  uint8_t base;
+  // CRC-8 of the generation and the packed slave matrix
+  uint8_t checksum;
+  // Map of the rows sent, followed by the rows
+  uint8_t data[SPLIT_ROW_MAP_BYTES + ROWS_PER_HAND * SPLIT_ROW_BYTES];
+} split_delta_msg_t;
+
+// Size of a message that only carries the generation
+#define SPLIT_DELTA_UNCHANGED_SIZE 1
+
+// Master to slave
+typedef struct {
+  // Generation of the master's copy
+  uint8_t generation;
+  // Nonzero asks for a full copy
+  uint8_t resync;
+} split_delta_ack_t;
+
+typedef struct {
+  matrix_row_t matrix[ROWS_PER_HAND];
+  // The state the master acknowledged
+  matrix_row_t base[ROWS_PER_HAND];
+  uint8_t      generation;
+  uint8_t      base_generation;
+  bool         synced;
+  // The generation wrapped onto base_generation without an acknowledgement,
+  // so an acknowledgement of base_generation can be stale. Full copies are
+  // sent until the master acknowledges another generation.
+  bool         wrapped;
+} split_delta_slave_t;
+
+typedef struct {
+  matrix_row_t matrix[ROWS_PER_HAND];
+  uint8_t      generation;
+  bool         synced;
+  uint16_t     updates;
+} split_delta_master_t;
+
+void    split_pack_rows(uint8_t *packed, const matrix_row_t rows[], uint8_t count);
+void    split_unpack_rows(matrix_row_t rows[], const uint8_t *packed, uint8_t count);
+uint8_t split_crc8(const uint8_t *data, uint8_t length, uint8_t crc);
+
+void split_delta_slave_init(split_delta_slave_t *slave);
+// Builds the message for matrix from the master's last acknowledgement and
+// returns its size
+uint8_t split_delta_slave_update(split_delta_slave_t *slave, const matrix_row_t matrix[], const split_delta_ack_t *ack, split_delta_msg_t *msg);
+
+void split_delta_master_init(split_delta_master_t *master, split_delta_ack_t *ack);
+// Applies a message of size bytes and fills in the acknowledgement for the
+// slave, returns false if the message was invalid or could not be applied
+bool split_delta_master_apply(split_delta_master_t *master, const split_delta_msg_t *msg, uint8_t size, split_delta_ack_t *ack);
@@ -12,4 +12,19 @@
     // When using serial and RGBLIGHT_SPLIT need separate transaction
     #define SERIAL_USE_MULTI_TRANSACTION
   #endif
+  // So do payloads registered with split_payload_register()
+  #if defined(SPLIT_TRANSPORT_PAYLOADS) && !defined(SERIAL_USE_MULTI_TRANSACTION)
+    #define SERIAL_USE_MULTI_TRANSACTION
+  #endif
+#endif
+
+#ifdef SPLIT_TRANSPORT_SERIAL_LINK
+  // serial_link defaults to frames of 1024 bytes for 8 slaves, far more than
+  // the state of one half needs
+  #ifndef MAX_FRAME_SIZE
+    #define MAX_FRAME_SIZE 48
+  #endif
+  #ifndef NUM_SLAVES
+    #define NUM_SLAVES 1
+  #endif
 #endif
@@ -345,6 +345,33 @@ uint8_t serial_recive_packet(uint8_t *buffer, uint8_t size) {
   return pecount == 0;
 }
 
+// Number of bytes of a length prefixed buffer to transfer, the length byte included
+static inline uint8_t prefixed_packet_size(uint8_t length, uint8_t size) {
+  return length < size ? length + 1 : size;
+}
+
+// Reads the length byte first, then the bytes it announces
+static uint8_t serial_recive_prefixed_packet(uint8_t *buffer, uint8_t size) NO_INLINE;
+static
+uint8_t serial_recive_prefixed_packet(uint8_t *buffer, uint8_t size) {
+  uint8_t pecount = 0;
+  sync_recv();
+  buffer[0] = serial_read_chunk(&pecount, 8);
+  // A length with a parity error can't be trusted. Stopping early would
+  // drive the line while the target still sends, so clock out the whole
+  // buffer, the longest answer the target can give.
+  if (pecount == 0) {
+    size = prefixed_packet_size(buffer[0], size);
+  }
+  for (uint8_t i = 1; i < size; ++i) {
+    uint8_t data;
+    sync_recv();
+    data = serial_read_chunk(&pecount, 8);
+    buffer[i] = data;
+  }
+  return pecount == 0;
+}
+
 inline static
 void change_sender2reciver(void) {
     sync_send();          //0
@@ -398,9 +425,12 @@ ISR(SERIAL_PIN_INTERRUPT) {
 #endif
 
   // target send phase
-  if( trans->target2initiator_buffer_size > 0 )
-      serial_send_packet((uint8_t *)trans->target2initiator_buffer,
-                         trans->target2initiator_buffer_size);
+  if( trans->target2initiator_buffer_size > 0 ) {
+      uint8_t size = trans->target2initiator_buffer_size;
+      if( trans->target2initiator_length_prefixed )
+          size = prefixed_packet_size(trans->target2initiator_buffer[0], size);
+      serial_send_packet((uint8_t *)trans->target2initiator_buffer, size);
+  }
   // target switch to input
   change_sender2reciver();
 
@@ -491,8 +521,14 @@ int  soft_serial_transaction(int sstd_index) {
   // initiator recive phase
   // if the target is present syncronize with it
   if( trans->target2initiator_buffer_size > 0 ) {
-      if (!serial_recive_packet((uint8_t *)trans->target2initiator_buffer,
-                                trans->target2initiator_buffer_size) ) {
+      uint8_t ok;
+      if( trans->target2initiator_length_prefixed )
+          ok = serial_recive_prefixed_packet((uint8_t *)trans->target2initiator_buffer,
+                                             trans->target2initiator_buffer_size);
+      else
+          ok = serial_recive_packet((uint8_t *)trans->target2initiator_buffer,
+                                    trans->target2initiator_buffer_size);
+      if (!ok) {
           serial_output();
           serial_high();
           *trans->status = TRANSACTION_DATA_ERROR;
@@ -28,6 +28,9 @@ typedef struct _SSTD_t  {
     uint8_t *initiator2target_buffer;
     uint8_t target2initiator_buffer_size;
     uint8_t *target2initiator_buffer;
+    // If set, the first byte of target2initiator_buffer holds the number of
+    // bytes that follow it and only those are sent
+    uint8_t target2initiator_length_prefixed;
 } SSTD_t;
 #define TID_LIMIT( table ) (sizeof(table) / sizeof(SSTD_t))
 
@@ -60,3 +63,12 @@ int  soft_serial_transaction(int sstd_index);
 #ifdef SERIAL_USE_MULTI_TRANSACTION
 int  soft_serial_get_and_clean_status(int sstd_index);
 #endif
+
+#ifdef SERIAL_USART
+// serial_usart.c only: starts a transaction without waiting for it, returns
+// false if one is still running
+bool serial_transaction_start(int sstd_index);
+// Returns TRANSACTION_BUSY until the transaction ends, then its result
+#define TRANSACTION_BUSY 0x10
+int  serial_transaction_poll(void);
+#endif
@@ -0,0 +1,81 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "serial_frame.h"
+#include "matrix_delta.h"
+
+uint8_t serial_frame_buffer_size(const uint8_t *buffer, uint8_t size, bool length_prefixed) {
+  if (!length_prefixed || size == 0) {
+    return size;
+  }
+  return buffer[0] < size ? buffer[0] + 1 : size;
+}
+
+void serial_frame_start_send(serial_frame_t *frame, uint8_t header, uint8_t *buffer, uint8_t size, bool length_prefixed) {
+  frame->buffer = buffer;
+  frame->size   = serial_frame_buffer_size(buffer, size, length_prefixed);
+  frame->index  = 0;
+  frame->header = header;
+  frame->crc    = split_crc8(&header, 1, 0);
+}
+
+int16_t serial_frame_next(serial_frame_t *frame) {
+  uint8_t i = frame->index++;
+
+  if (i == 0) {
+    return frame->header;
+  }
+  if (i <= frame->size) {
+    uint8_t byte = frame->buffer[i - 1];
+    frame->crc   = split_crc8(&byte, 1, frame->crc);
+    return byte;
+  }
+  if (i == frame->size + 1) {
+    return frame->crc;
+  }
+  frame->index = i;
+  return -1;
+}
+
+void serial_frame_start_receive(serial_frame_t *frame) {
+  frame->index = 0;
+  frame->size  = 0;
+}
+
+void serial_frame_expect(serial_frame_t *frame, uint8_t *buffer, uint8_t size, bool length_prefixed) {
+  frame->buffer          = buffer;
+  frame->size            = size;
+  frame->length_prefixed = length_prefixed;
+}
+
+uint8_t serial_frame_receive(serial_frame_t *frame, uint8_t byte) {
+  uint8_t i = frame->index++;
+
+  if (i == 0) {
+    frame->header = byte;
+    frame->crc    = split_crc8(&byte, 1, 0);
+    return SERIAL_FRAME_HEADER;
+  }
+  if (i <= frame->size) {
+    frame->buffer[i - 1] = byte;
+    frame->crc           = split_crc8(&byte, 1, frame->crc);
+    if (i == 1 && frame->length_prefixed) {
+      frame->size = serial_frame_buffer_size(frame->buffer, frame->size, true);
+    }
+    return SERIAL_FRAME_MORE;
+  }
+  return byte == frame->crc ? SERIAL_FRAME_DONE : SERIAL_FRAME_CRC_ERROR;
+}
@@ -0,0 +1,67 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Byte at a time framing for the USART split transport.
+ *
+ * A frame is a header byte, the bytes of a transaction buffer and a CRC-8 of
+ * both. The initiator's header carries the transaction id, the target answers
+ * every frame it accepted the header of with an ACK or NAK header, depending
+ * on the CRC of what it received, followed by its own buffer:
+ *
+ *   initiator: SERIAL_FRAME_REQUEST | tid, initiator2target_buffer, crc
+ *   target:    SERIAL_FRAME_ACK or NAK,    target2initiator_buffer, crc
+ *
+ * Length prefixed buffers only send the bytes their first byte announces.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SERIAL_FRAME_REQUEST 0xA0
+#define SERIAL_FRAME_TID_MASK 0x0F
+#define SERIAL_FRAME_ACK 0x5A
+#define SERIAL_FRAME_NAK 0x55
+
+// Results of serial_frame_receive()
+#define SERIAL_FRAME_MORE 0
+// The header arrived, call serial_frame_expect() before the next byte
+#define SERIAL_FRAME_HEADER 1
+#define SERIAL_FRAME_DONE 2
+#define SERIAL_FRAME_CRC_ERROR 3
+
+typedef struct {
+  uint8_t *buffer;
+  uint8_t  size;
+  // Bytes of the frame handled so far, the header included
+  uint8_t index;
+  uint8_t crc;
+  uint8_t header;
+  bool    length_prefixed;
+} serial_frame_t;
+
+// Number of bytes of a buffer to transfer, the length byte included
+uint8_t serial_frame_buffer_size(const uint8_t *buffer, uint8_t size, bool length_prefixed);
+
+void serial_frame_start_send(serial_frame_t *frame, uint8_t header, uint8_t *buffer, uint8_t size, bool length_prefixed);
+// Returns the next byte to send, or -1 after the CRC
+int16_t serial_frame_next(serial_frame_t *frame);
+
+void serial_frame_start_receive(serial_frame_t *frame);
+void serial_frame_expect(serial_frame_t *frame, uint8_t *buffer, uint8_t size, bool length_prefixed);
+uint8_t serial_frame_receive(serial_frame_t *frame, uint8_t byte);
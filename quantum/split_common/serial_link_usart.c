@@ -0,0 +1,109 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef F_CPU
+#  define F_CPU 16000000
+#endif
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "serial_link_usart.h"
+#include "serial_link/protocol/byte_stuffer.h"
+#include "serial_link/protocol/physical.h"
+
+#ifndef __AVR_ATmega32U4__
+#  error serial_link_usart.c supports the ATmega32U4 only
+#endif
+
+#ifndef SERIAL_USART_SPEED
+#  define SERIAL_USART_SPEED 1000000
+#endif
+#define SERIAL_USART_UBRR ((F_CPU / (8UL * SERIAL_USART_SPEED)) - 1)
+
+// Both have to be powers of two
+#ifndef SERIAL_LINK_RX_BUFFER_SIZE
+#  define SERIAL_LINK_RX_BUFFER_SIZE 64
+#endif
+#ifndef SERIAL_LINK_TX_BUFFER_SIZE
+#  define SERIAL_LINK_TX_BUFFER_SIZE 64
+#endif
+
+static uint8_t          rx_buffer[SERIAL_LINK_RX_BUFFER_SIZE];
+static volatile uint8_t rx_head;
+static uint8_t          rx_tail;
+static uint8_t          tx_buffer[SERIAL_LINK_TX_BUFFER_SIZE];
+static uint8_t          tx_head;
+static volatile uint8_t tx_tail;
+static uint8_t          usart_link;
+
+void serial_link_usart_init(uint8_t link) {
+  usart_link = link;
+  rx_head = rx_tail = 0;
+  tx_head = tx_tail = 0;
+
+  UBRR1  = SERIAL_USART_UBRR;
+  UCSR1A = _BV(U2X1);
+  // 8 data bits, no parity, 1 stop bit, the frames carry a CRC
+  UCSR1C = _BV(UCSZ11) | _BV(UCSZ10);
+  // pull-up on RXD1, so a missing other half reads as an idle line
+  DDRD &= ~_BV(PD2);
+  PORTD |= _BV(PD2);
+  UCSR1B = _BV(RXEN1) | _BV(TXEN1) | _BV(RXCIE1);
+}
+
+// A full buffer drops the byte, the byte stuffer and the CRC reject the frame
+ISR(USART1_RX_vect) {
+  uint8_t data = UDR1;
+  uint8_t next = (rx_head + 1) & (SERIAL_LINK_RX_BUFFER_SIZE - 1);
+  if (next != rx_tail) {
+    rx_buffer[rx_head] = data;
+    rx_head            = next;
+  }
+}
+
+ISR(USART1_UDRE_vect) {
+  uint8_t tail = tx_tail;
+  UDR1         = tx_buffer[tail];
+  tx_tail = tail = (tail + 1) & (SERIAL_LINK_TX_BUFFER_SIZE - 1);
+  if (tail == tx_head) {
+    UCSR1B &= ~_BV(UDRIE1);
+  }
+}
+
+void serial_link_usart_receive(void) {
+  while (rx_tail != rx_head) {
+    byte_stuffer_recv_byte(usart_link, rx_buffer[rx_tail]);
+    rx_tail = (rx_tail + 1) & (SERIAL_LINK_RX_BUFFER_SIZE - 1);
+  }
+}
+
+// Only waits when a frame does not fit into what is left of the buffer
+void send_data(uint8_t link, const uint8_t *data, uint16_t size) {
+  if (link != usart_link) {
+    return;
+  }
+  while (size--) {
+    uint8_t next = (tx_head + 1) & (SERIAL_LINK_TX_BUFFER_SIZE - 1);
+    while (next == tx_tail) {
+    }
+    tx_buffer[tx_head] = *data++;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      tx_head = next;
+      UCSR1B |= _BV(UDRIE1);
+    }
+  }
+}
@@ -0,0 +1,34 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Physical layer of serial_link for split keyboards: full duplex on USART1
+ * of the ATmega32U4, TXD1 (D3) of each half wired to RXD1 (D2) of the other.
+ *
+ * The USART interrupts only move bytes between the line and two ring
+ * buffers. send_data() queues bytes, serial_link_usart_receive() hands the
+ * received ones to the byte stuffer from the main loop, so frames are
+ * decoded and written into their triple buffers outside of interrupts.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// link is the serial_link link the USART stands for, UP_LINK on the slave
+// and DOWN_LINK on the master
+void serial_link_usart_init(uint8_t link);
+void serial_link_usart_receive(void);
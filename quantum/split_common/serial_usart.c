@@ -0,0 +1,287 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Split transport over the hardware USART, half-duplex on a single wire.
+ *
+ * Implements the serial.h API with the framing of serial_frame.h. Transfers
+ * are driven by the USART interrupts: the initiator starts a transaction with
+ * serial_transaction_start() and keeps running until serial_transaction_poll()
+ * returns the result; soft_serial_transaction() does both and waits.
+ *
+ * On each half TXD1 (D3) and RXD1 (D2) are joined, and the halves share that
+ * line. A half only enables its transmitter while it sends, otherwise D3 is an
+ * input with pull-up like D2, so the line idles high.
+ */
+
+#ifndef F_CPU
+#  define F_CPU 16000000
+#endif
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "serial.h"
+#include "serial_frame.h"
+#include "timer.h"
+
+#ifndef __AVR_ATmega32U4__
+#  error serial_usart.c supports the ATmega32U4 only
+#endif
+
+#ifndef SERIAL_USART_SPEED
+#  define SERIAL_USART_SPEED 1000000
+#endif
+#define SERIAL_USART_UBRR ((F_CPU / (8UL * SERIAL_USART_SPEED)) - 1)
+
+// How long the initiator waits for the target to answer
+#ifndef SERIAL_USART_TIMEOUT_US
+#  define SERIAL_USART_TIMEOUT_US 500
+#endif
+// A pause this long ends any frame in progress
+#ifndef SERIAL_USART_FRAME_GAP_US
+#  define SERIAL_USART_FRAME_GAP_US 100
+#endif
+
+// In timer_read_ticks() units, so the interrupts never convert to microseconds
+#define SERIAL_USART_TIMEOUT_TICKS ((uint32_t)SERIAL_USART_TIMEOUT_US * TIMER_RAW_TOP / 1000)
+#define SERIAL_USART_FRAME_GAP_TICKS ((uint32_t)SERIAL_USART_FRAME_GAP_US * TIMER_RAW_TOP / 1000)
+
+#define SERIAL_USART_PINS (_BV(PD2) | _BV(PD3))
+#define SERIAL_USART_ERRORS (_BV(FE1) | _BV(DOR1) | _BV(UPE1))
+
+enum serial_usart_state {
+  STATE_IDLE,
+  STATE_SENDING,
+  STATE_RECEIVING,
+  // Ignores the rest of a frame until the line pauses
+  STATE_DISCARD,
+};
+
+static SSTD_t *Transaction_table      = NULL;
+static uint8_t Transaction_table_size = 0;
+
+static serial_frame_t    frame;
+static SSTD_t *          current;
+static volatile uint8_t  state;
+static volatile uint8_t  result;
+static volatile uint32_t last_activity;
+static bool              is_initiator;
+static bool              nak;
+static bool              line_error;
+
+static void usart_init(void) {
+  UBRR1  = SERIAL_USART_UBRR;
+  UCSR1A = _BV(U2X1);
+  // 8 data bits, even parity, 1 stop bit
+  UCSR1C = _BV(UPM11) | _BV(UCSZ11) | _BV(UCSZ10);
+  DDRD &= ~SERIAL_USART_PINS;
+  PORTD |= SERIAL_USART_PINS;
+  UCSR1B = _BV(RXEN1) | _BV(RXCIE1);
+}
+
+static void start_receive(uint8_t new_state) {
+  serial_frame_start_receive(&frame);
+  line_error    = false;
+  state         = new_state;
+  last_activity = timer_read_ticks();
+}
+
+// The receiver is off while sending, so a half does not hear its own frame
+static void start_send(void) {
+  state  = STATE_SENDING;
+  UCSR1A = _BV(U2X1) | _BV(TXC1);
+  UCSR1B = _BV(TXEN1) | _BV(UDRIE1);
+}
+
+void soft_serial_initiator_init(SSTD_t *sstd_table, int sstd_table_size) {
+  Transaction_table      = sstd_table;
+  Transaction_table_size = (uint8_t)sstd_table_size;
+  is_initiator           = true;
+  result                 = TRANSACTION_END;
+  state                  = STATE_IDLE;
+  usart_init();
+}
+
+void soft_serial_target_init(SSTD_t *sstd_table, int sstd_table_size) {
+  Transaction_table      = sstd_table;
+  Transaction_table_size = (uint8_t)sstd_table_size;
+  is_initiator           = false;
+  usart_init();
+  start_receive(STATE_IDLE);
+}
+
+ISR(USART1_UDRE_vect) {
+  int16_t byte = serial_frame_next(&frame);
+  if (byte >= 0) {
+    UDR1 = byte;
+  } else {
+    UCSR1B = _BV(TXEN1) | _BV(TXCIE1);
+  }
+}
+
+// The last stop bit left the shift register, release the line
+ISR(USART1_TX_vect) {
+  UCSR1B = _BV(RXEN1) | _BV(RXCIE1);
+  start_receive(is_initiator ? STATE_RECEIVING : STATE_IDLE);
+}
+
+static void target_receive(uint8_t byte) {
+  uint8_t received = serial_frame_receive(&frame, byte);
+
+  switch (received) {
+    case SERIAL_FRAME_HEADER: {
+      uint8_t tid = byte & SERIAL_FRAME_TID_MASK;
+      if ((byte & ~SERIAL_FRAME_TID_MASK) != SERIAL_FRAME_REQUEST || tid >= Transaction_table_size) {
+        state = STATE_DISCARD;
+        return;
+      }
+      current = &Transaction_table[tid];
+      serial_frame_expect(&frame, current->initiator2target_buffer, current->initiator2target_buffer_size, false);
+      state = STATE_RECEIVING;
+      break;
+    }
+    case SERIAL_FRAME_DONE:
+    case SERIAL_FRAME_CRC_ERROR: {
+      bool ok          = received == SERIAL_FRAME_DONE && !line_error;
+      *current->status = ok ? TRANSACTION_ACCEPTED : TRANSACTION_DATA_ERROR;
+      serial_frame_start_send(&frame, ok ? SERIAL_FRAME_ACK : SERIAL_FRAME_NAK, current->target2initiator_buffer, current->target2initiator_buffer_size, current->target2initiator_length_prefixed);
+      start_send();
+      break;
+    }
+  }
+}
+
+static void initiator_finish(uint8_t transaction_result) {
+  result           = transaction_result;
+  *current->status = transaction_result;
+  state            = STATE_IDLE;
+}
+
+static void initiator_receive(uint8_t byte) {
+  switch (serial_frame_receive(&frame, byte)) {
+    case SERIAL_FRAME_HEADER:
+      if (byte != SERIAL_FRAME_ACK && byte != SERIAL_FRAME_NAK) {
+        // poll() reports the error once the line is quiet again
+        result = TRANSACTION_DATA_ERROR;
+        state  = STATE_DISCARD;
+        return;
+      }
+      nak = byte == SERIAL_FRAME_NAK;
+      serial_frame_expect(&frame, current->target2initiator_buffer, current->target2initiator_buffer_size, current->target2initiator_length_prefixed);
+      break;
+    case SERIAL_FRAME_DONE:
+      initiator_finish(line_error || nak ? TRANSACTION_DATA_ERROR : TRANSACTION_END);
+      break;
+    case SERIAL_FRAME_CRC_ERROR:
+      initiator_finish(TRANSACTION_DATA_ERROR);
+      break;
+  }
+}
+
+ISR(USART1_RX_vect) {
+  uint8_t  errors = UCSR1A & SERIAL_USART_ERRORS;
+  uint8_t  byte   = UDR1;
+  uint32_t now    = timer_read_ticks();
+
+  if (!is_initiator && now - last_activity > SERIAL_USART_FRAME_GAP_TICKS) {
+    // a new frame, whatever happened to the last one
+    serial_frame_start_receive(&frame);
+    line_error = false;
+    state      = STATE_IDLE;
+  }
+  last_activity = now;
+  if (state == STATE_DISCARD || (is_initiator && state != STATE_RECEIVING)) {
+    return;
+  }
+  line_error |= errors != 0;
+  if (is_initiator) {
+    initiator_receive(byte);
+  } else {
+    target_receive(byte);
+  }
+}
+
+bool serial_transaction_start(int sstd_index) {
+  if (sstd_index >= Transaction_table_size || serial_transaction_poll() == TRANSACTION_BUSY) {
+    return false;
+  }
+  current = &Transaction_table[sstd_index];
+  serial_frame_start_send(&frame, SERIAL_FRAME_REQUEST | sstd_index, current->initiator2target_buffer, current->initiator2target_buffer_size, false);
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { start_send(); }
+  return true;
+}
+
+int serial_transaction_poll(void) {
+  uint8_t  current_state;
+  uint32_t idle;
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    current_state = state;
+    idle          = last_activity;
+  }
+  idle = timer_read_ticks() - idle;
+  switch (current_state) {
+    case STATE_IDLE:
+      return result;
+    case STATE_SENDING:
+      return TRANSACTION_BUSY;
+    case STATE_DISCARD:
+      if (idle <= SERIAL_USART_FRAME_GAP_TICKS) {
+        return TRANSACTION_BUSY;
+      }
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { initiator_finish(TRANSACTION_DATA_ERROR); }
+      return TRANSACTION_DATA_ERROR;
+    default:
+      if (idle <= SERIAL_USART_TIMEOUT_TICKS) {
+        return TRANSACTION_BUSY;
+      }
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        // only part of the answer arrived
+        initiator_finish(frame.index > 0 ? TRANSACTION_DATA_ERROR : TRANSACTION_NO_RESPONSE);
+      }
+      return result;
+  }
+}
+
+#ifndef SERIAL_USE_MULTI_TRANSACTION
+int soft_serial_transaction(void) {
+  int sstd_index = 0;
+#else
+int soft_serial_transaction(int sstd_index) {
+#endif
+  int status;
+
+  if (!serial_transaction_start(sstd_index)) {
+    return TRANSACTION_TYPE_ERROR;
+  }
+  while ((status = serial_transaction_poll()) == TRANSACTION_BUSY) {
+  }
+  return status;
+}
+
+#ifdef SERIAL_USE_MULTI_TRANSACTION
+int soft_serial_get_and_clean_status(int sstd_index) {
+  SSTD_t *trans = &Transaction_table[sstd_index];
+  cli();
+  int retval     = *trans->status;
+  *trans->status = 0;
+  sei();
+  return retval;
+}
+#endif
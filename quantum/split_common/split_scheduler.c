@@ -0,0 +1,102 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "split_scheduler.h"
+
+static split_slot_t slots[SPLIT_SCHEDULER_SLOTS];
+static bool         tried[SPLIT_SCHEDULER_SLOTS];
+static uint8_t      slot_count;
+static bool         sent_this_scan;
+
+void split_scheduler_init(void) {
+  memset(slots, 0, sizeof(slots));
+  slot_count = 0;
+}
+
+int8_t split_scheduler_add(uint8_t priority) {
+  if (slot_count >= SPLIT_SCHEDULER_SLOTS) {
+    return -1;
+  }
+  slots[slot_count].priority = priority;
+  return slot_count++;
+}
+
+void split_scheduler_set_pending(uint8_t slot) { slots[slot].pending = true; }
+
+bool split_scheduler_is_pending(uint8_t slot) { return slots[slot].pending; }
+
+const split_slot_t *split_scheduler_slot(uint8_t slot) { return &slots[slot]; }
+
+void split_scheduler_begin_scan(void) {
+  sent_this_scan = false;
+  for (uint8_t i = 0; i < slot_count; i++) {
+    tried[i] = false;
+    if (slots[i].pending && slots[i].waited < UINT8_MAX) {
+      slots[i].waited++;
+    }
+  }
+}
+
+static bool overdue(uint8_t slot) { return slots[slot].waited >= SPLIT_SCHEDULER_MAX_WAIT; }
+
+int8_t split_scheduler_next(uint16_t remaining_us) {
+  int8_t   top = -1, fitting = -1;
+  uint16_t top_score = 0, fitting_score = 0;
+
+  for (uint8_t i = 0; i < slot_count; i++) {
+    if (!slots[i].pending || tried[i]) {
+      continue;
+    }
+    uint16_t score = slots[i].priority + slots[i].waited;
+    if (top < 0 || score > top_score) {
+      top       = i;
+      top_score = score;
+    }
+    // a slot that never ran yet goes alone, its cost is unknown
+    bool fits = slots[i].cost_us ? slots[i].cost_us <= remaining_us : !sent_this_scan;
+    if (fits && (fitting < 0 || score > fitting_score)) {
+      fitting       = i;
+      fitting_score = score;
+    }
+  }
+
+  if (top >= 0 && top != fitting && overdue(top)) {
+    // Over budget, but only alone: if something was sent already, keep the
+    // rest of the scan free so it goes first in the next one
+    fitting = sent_this_scan ? -1 : top;
+  }
+  if (fitting >= 0) {
+    tried[fitting] = true;
+  }
+  return fitting;
+}
+
+void split_scheduler_done(uint8_t slot, bool ok, uint16_t cost_us) {
+  split_slot_t *s = &slots[slot];
+
+  sent_this_scan = true;
+  if (cost_us >= s->cost_us) {
+    s->cost_us = cost_us;
+  } else {
+    // let the estimate decay slowly after a slow transfer
+    s->cost_us -= (s->cost_us - cost_us) / 8;
+  }
+  if (ok) {
+    s->pending = false;
+    s->waited  = 0;
+  }
+}
@@ -0,0 +1,76 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Decides which split transactions besides the matrix run in a scan.
+ *
+ * The matrix is always transferred first. The pending slots then share what
+ * is left of SPLIT_TRANSPORT_BUDGET_US, highest priority first, each at most
+ * once per scan. Every scan a slot waits raises its priority by one, and a
+ * slot that waited SPLIT_SCHEDULER_MAX_WAIT scans may exceed the budget if
+ * nothing else was sent in that scan, so large or low priority transfers are
+ * delayed but never starved. The first transfer of a slot, whose duration is
+ * not known yet, also only runs alone.
+ *
+ * The scheduler does not run or time the transfers itself:
+ *
+ *   split_scheduler_begin_scan();
+ *   while ((slot = split_scheduler_next(remaining_us)) >= 0) {
+ *       ok = <run the transfer>;
+ *       split_scheduler_done(slot, ok, <its duration>);
+ *   }
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef SPLIT_SCHEDULER_SLOTS
+#  define SPLIT_SCHEDULER_SLOTS 8
+#endif
+
+// Time a scan may spend on split transfers, the matrix included
+#ifndef SPLIT_TRANSPORT_BUDGET_US
+#  define SPLIT_TRANSPORT_BUDGET_US 1000
+#endif
+
+#ifndef SPLIT_SCHEDULER_MAX_WAIT
+#  define SPLIT_SCHEDULER_MAX_WAIT 16
+#endif
+
+typedef struct {
+  // Duration of recent transfers, the estimate for the next one
+  uint16_t cost_us;
+  uint8_t  priority;
+  // Scans spent pending
+  uint8_t waited;
+  bool    pending;
+} split_slot_t;
+
+void   split_scheduler_init(void);
+// Returns the new slot, or -1 if all slots are taken
+int8_t split_scheduler_add(uint8_t priority);
+// A slot stays pending until a transfer of it succeeds
+void   split_scheduler_set_pending(uint8_t slot);
+bool   split_scheduler_is_pending(uint8_t slot);
+
+void   split_scheduler_begin_scan(void);
+// Returns the slot to transfer next, or -1 if none fits into remaining_us
+int8_t split_scheduler_next(uint16_t remaining_us);
+void   split_scheduler_done(uint8_t slot, bool ok, uint16_t cost_us);
+
+const split_slot_t *split_scheduler_slot(uint8_t slot);
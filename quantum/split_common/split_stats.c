@@ -0,0 +1,88 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "split_stats.h"
+#include "print.h"
+
+static split_link_stats_t stats;
+
+// Ids whose last transaction failed
+static uint16_t failed;
+
+void split_link_stats_record(uint8_t id, uint8_t result, uint8_t bytes, uint16_t duration_us) {
+  uint16_t bit = 1 << id;
+
+  stats.transactions++;
+  if (failed & bit) {
+    stats.retries++;
+  }
+  switch (result) {
+    case SPLIT_LINK_OK:
+      failed &= ~bit;
+      stats.bytes += bytes;
+      break;
+    case SPLIT_LINK_NO_RESPONSE:
+      failed |= bit;
+      stats.no_response++;
+      break;
+    default:
+      failed |= bit;
+      stats.data_errors++;
+      break;
+  }
+  if (duration_us > stats.worst_us) {
+    stats.worst_us = duration_us;
+  }
+}
+
+void split_link_stats_reject(uint8_t id) {
+  failed |= 1 << id;
+  stats.data_errors++;
+}
+
+const split_link_stats_t *split_link_stats_get(void) { return &stats; }
+
+void split_link_stats_reset(void) {
+  memset(&stats, 0, sizeof(stats));
+  failed = 0;
+}
+
+void split_link_stats_print(void) {
+  print("\n\t- Split link -\ntransactions retries no_response data_errors bytes worst_us\n");
+  xprintf("%lu %lu %lu %lu %lu %u\n", (unsigned long)stats.transactions, (unsigned long)stats.retries, (unsigned long)stats.no_response, (unsigned long)stats.data_errors, (unsigned long)stats.bytes, stats.worst_us);
+}
+
+static uint8_t *pack(uint8_t *data, uint32_t value, uint8_t size) {
+  while (size--) {
+    *data++ = value;
+    value >>= 8;
+  }
+  return data;
+}
+
+uint8_t split_link_stats_pack(uint8_t *data, uint8_t length) {
+  if (length < SPLIT_LINK_STATS_PACKED_SIZE) {
+    return 0;
+  }
+  data = pack(data, stats.transactions, 4);
+  data = pack(data, stats.retries, 4);
+  data = pack(data, stats.no_response, 4);
+  data = pack(data, stats.data_errors, 4);
+  data = pack(data, stats.bytes, 4);
+  pack(data, stats.worst_us, 2);
+  return SPLIT_LINK_STATS_PACKED_SIZE;
+}
@@ -0,0 +1,65 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* Quality of the link between the halves, as seen by the master. Every
+ * transaction the transport starts is counted, a transaction started again
+ * after a failure of the same id is also a retry. Bytes are those of
+ * successful transactions, in both directions. */
+typedef struct {
+  uint32_t transactions;
+  uint32_t retries;
+  uint32_t no_response;
+  uint32_t data_errors;
+  uint32_t bytes;
+  uint16_t worst_us;
+} split_link_stats_t;
+
+enum split_link_result {
+  SPLIT_LINK_OK,
+  SPLIT_LINK_NO_RESPONSE,
+  SPLIT_LINK_DATA_ERROR,
+};
+
+// Size of the split_link_stats_pack() output
+#define SPLIT_LINK_STATS_PACKED_SIZE 22
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+
+#  define SPLIT_LINK_STATS_RECORD(id, result, bytes, duration_us) split_link_stats_record(id, result, bytes, duration_us)
+#  define SPLIT_LINK_STATS_REJECT(id) split_link_stats_reject(id)
+
+// id tells transactions apart for counting retries, it has to be below 16
+void                      split_link_stats_record(uint8_t id, uint8_t result, uint8_t bytes, uint16_t duration_us);
+// The last transaction of id arrived intact but its contents were rejected,
+// such as a matrix delta that failed its checksum
+void                      split_link_stats_reject(uint8_t id);
+const split_link_stats_t *split_link_stats_get(void);
+void                      split_link_stats_reset(void);
+void                      split_link_stats_print(void);
+// Writes the counters little endian in the order of split_link_stats_t, for
+// raw HID. Returns the bytes written, 0 if length is too short.
+uint8_t                   split_link_stats_pack(uint8_t *data, uint8_t length);
+
+#else
+
+#  define SPLIT_LINK_STATS_RECORD(id, result, bytes, duration_us)
+#  define SPLIT_LINK_STATS_REJECT(id)
+
+#endif
@@ -4,6 +4,7 @@
 #include "config.h"
 #include "matrix.h"
 #include "quantum.h"
+#include "transport.h"
 
 #define ROWS_PER_HAND (MATRIX_ROWS / 2)
 
@@ -19,13 +20,28 @@
 #  include "encoder.h"
 #endif
 
+#include "matrix_delta.h"
+#include "split_stats.h"
+
+#ifdef SPLIT_TRANSPORT_DELTA
+static split_delta_master_t delta_master;
+static split_delta_slave_t  delta_slave;
+#endif
+
 #if defined(USE_I2C) || defined(EH)
 
 #  include "i2c_master.h"
 #  include "i2c_slave.h"
 
 typedef struct _I2C_slave_buffer_t {
+#ifdef SPLIT_TRANSPORT_DELTA
+    split_delta_ack_t delta_ack;
+    // size of the delta message, read together with its generation
+    uint8_t           delta_size;
+    split_delta_msg_t delta;
+#else
     matrix_row_t smatrix[ROWS_PER_HAND];
+#endif
     uint8_t      backlight_level;
 #if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
     rgblight_syncinfo_t rgblight_sync;
@@ -35,11 +51,21 @@ typedef struct _I2C_slave_buffer_t {
 #endif
 } I2C_slave_buffer_t;
 
+#  ifdef SPLIT_TRANSPORT_DELTA
+// The delta message makes the state larger than the matrix it replaces
+_Static_assert(sizeof(I2C_slave_buffer_t) <= I2C_SLAVE_REG_COUNT, "The split state does not fit into the I2C_SLAVE_REG_COUNT registers of the slave");
+#  endif
+
 static I2C_slave_buffer_t * const i2c_buffer = (I2C_slave_buffer_t *)i2c_slave_reg;
 
 #  define I2C_BACKLIGHT_START offsetof(I2C_slave_buffer_t, backlight_level)
 #  define I2C_RGB_START offsetof(I2C_slave_buffer_t, rgblight_sync)
-#  define I2C_KEYMAP_START offsetof(I2C_slave_buffer_t, smatrix)
+#  ifdef SPLIT_TRANSPORT_DELTA
+#    define I2C_DELTA_ACK_START offsetof(I2C_slave_buffer_t, delta_ack)
+#    define I2C_DELTA_START offsetof(I2C_slave_buffer_t, delta_size)
+#  else
+#    define I2C_KEYMAP_START offsetof(I2C_slave_buffer_t, smatrix)
+#  endif
 #  define I2C_ENCODER_START offsetof(I2C_slave_buffer_t, encoder_state)
 
 #  define TIMEOUT 100
@@ -48,15 +74,80 @@ static I2C_slave_buffer_t * const i2c_buffer = (I2C_slave_buffer_t *)i2c_slave_r
 #    define SLAVE_I2C_ADDRESS 0x32
 #  endif
 
+// Tells the transfers apart in the link statistics
+enum i2c_transfer_id {
+  I2C_TRANSFER_MATRIX,
+  I2C_TRANSFER_DELTA_ACK,
+  I2C_TRANSFER_BACKLIGHT,
+  I2C_TRANSFER_RGB,
+  I2C_TRANSFER_ENCODER,
+};
+
+#  ifdef SPLIT_LINK_STATS_ENABLE
+// A failed address or a timeout both mean the slave did not answer
+static i2c_status_t i2c_record(uint8_t id, i2c_status_t status, uint8_t bytes, uint32_t begin) {
+  SPLIT_LINK_STATS_RECORD(id, status >= 0 ? SPLIT_LINK_OK : SPLIT_LINK_NO_RESPONSE, bytes, timer_elapsed_us(begin));
+  return status;
+}
+
+static i2c_status_t i2c_read_recorded(uint8_t id, uint8_t regaddr, uint8_t *data, uint8_t length) {
+  uint32_t begin = timer_read_ticks();
+  return i2c_record(id, i2c_readReg(SLAVE_I2C_ADDRESS, regaddr, data, length, TIMEOUT), length, begin);
+}
+
+static i2c_status_t i2c_write_recorded(uint8_t id, uint8_t regaddr, uint8_t *data, uint8_t length) {
+  uint32_t begin = timer_read_ticks();
+  return i2c_record(id, i2c_writeReg(SLAVE_I2C_ADDRESS, regaddr, data, length, TIMEOUT), length, begin);
+}
+#  else
+#    define i2c_read_recorded(id, regaddr, data, length) i2c_readReg(SLAVE_I2C_ADDRESS, regaddr, data, length, TIMEOUT)
+#    define i2c_write_recorded(id, regaddr, data, length) i2c_writeReg(SLAVE_I2C_ADDRESS, regaddr, data, length, TIMEOUT)
+#  endif
+
+#  ifdef SPLIT_TRANSPORT_DELTA
+// Reads the size and generation first, the rest of the message only if it changed
+static bool transport_delta_master(matrix_row_t matrix[]) {
+  if (i2c_read_recorded(I2C_TRANSFER_MATRIX, I2C_DELTA_START, (void *)&i2c_buffer->delta_size, 2) < 0) {
+    return false;
+  }
+  uint8_t size = i2c_buffer->delta_size;
+  if (size > SPLIT_DELTA_UNCHANGED_SIZE && size <= sizeof(split_delta_msg_t)) {
+    if (i2c_read_recorded(I2C_TRANSFER_MATRIX, I2C_DELTA_START + 2, (void *)&i2c_buffer->delta.base, size - 1) < 0) {
+      return false;
+    }
+  }
+
+  split_delta_ack_t ack;
+  bool              ok = split_delta_master_apply(&delta_master, &i2c_buffer->delta, size, &ack);
+  if (!ok) {
+    SPLIT_LINK_STATS_REJECT(I2C_TRANSFER_MATRIX);
+  }
+  if (memcmp(&ack, &i2c_buffer->delta_ack, sizeof(ack)) != 0) {
+    if (i2c_write_recorded(I2C_TRANSFER_DELTA_ACK, I2C_DELTA_ACK_START, (void *)&ack, sizeof(ack)) >= 0) {
+      i2c_buffer->delta_ack = ack;
+    }
+  }
+  if (ok) {
+    memcpy(matrix, delta_master.matrix, sizeof(delta_master.matrix));
+  }
+  return ok;
+}
+#  endif
+
 // Get rows from other half over i2c
 bool transport_master(matrix_row_t matrix[]) {
-  i2c_readReg(SLAVE_I2C_ADDRESS, I2C_KEYMAP_START, (void *)matrix, sizeof(i2c_buffer->smatrix), TIMEOUT);
+#  ifdef SPLIT_TRANSPORT_DELTA
+  bool ok = transport_delta_master(matrix);
+#  else
+  bool ok = true;
+  i2c_read_recorded(I2C_TRANSFER_MATRIX, I2C_KEYMAP_START, (void *)matrix, sizeof(i2c_buffer->smatrix));
+#  endif
 
   // write backlight info
 #  ifdef BACKLIGHT_ENABLE
   uint8_t level = is_backlight_enabled() ? get_backlight_level() : 0;
   if (level != i2c_buffer->backlight_level) {
-    if (i2c_writeReg(SLAVE_I2C_ADDRESS, I2C_BACKLIGHT_START, (void *)&level, sizeof(level), TIMEOUT) >= 0) {
+    if (i2c_write_recorded(I2C_TRANSFER_BACKLIGHT, I2C_BACKLIGHT_START, (void *)&level, sizeof(level)) >= 0) {
       i2c_buffer->backlight_level = level;
     }
   }
@@ -66,24 +157,28 @@ bool transport_master(matrix_row_t matrix[]) {
   if (rgblight_get_change_flags()) {
     rgblight_syncinfo_t rgblight_sync;
     rgblight_get_syncinfo(&rgblight_sync);
-    if (i2c_writeReg(SLAVE_I2C_ADDRESS, I2C_RGB_START,
-                     (void *)&rgblight_sync, sizeof(rgblight_sync), TIMEOUT) >= 0) {
+    if (i2c_write_recorded(I2C_TRANSFER_RGB, I2C_RGB_START,
+                           (void *)&rgblight_sync, sizeof(rgblight_sync)) >= 0) {
       rgblight_clear_change_flags();
     }
   }
 #  endif
 
 #  ifdef ENCODER_ENABLE
-  i2c_readReg(SLAVE_I2C_ADDRESS, I2C_ENCODER_START, (void *)i2c_buffer->encoder_state, sizeof(I2C_slave_buffer_t.encoder_state), TIMEOUT);
+  i2c_read_recorded(I2C_TRANSFER_ENCODER, I2C_ENCODER_START, (void *)i2c_buffer->encoder_state, sizeof(I2C_slave_buffer_t.encoder_state));
   encoder_update_raw(i2c_buffer->encoder_state);
 #  endif
 
-  return true;
+  return ok;
 }
 
 void transport_slave(matrix_row_t matrix[]) {
+#  ifdef SPLIT_TRANSPORT_DELTA
+  i2c_buffer->delta_size = split_delta_slave_update(&delta_slave, matrix, &i2c_buffer->delta_ack, &i2c_buffer->delta);
+#  else
   // Copy matrix to I2C buffer
   memcpy((void*)i2c_buffer->smatrix, (void *)matrix, sizeof(i2c_buffer->smatrix));
+#  endif
 
 // Read Backlight Info
 #  ifdef BACKLIGHT_ENABLE
@@ -103,28 +198,56 @@ void transport_slave(matrix_row_t matrix[]) {
 #  endif
 }
 
-void transport_master_init(void) { i2c_init(); }
+void transport_master_init(void) {
+#  ifdef SPLIT_TRANSPORT_DELTA
+  split_delta_master_init(&delta_master, &i2c_buffer->delta_ack);
+  // differs from any acknowledgement, so the first one is written
+  i2c_buffer->delta_ack.resync = 0xFF;
+#  endif
+  i2c_init();
+}
+
+void transport_slave_init(void) {
+#  ifdef SPLIT_TRANSPORT_DELTA
+  split_delta_slave_init(&delta_slave);
+  // send full copies until the master acknowledges one
+  i2c_buffer->delta_ack.resync = 1;
+#  endif
+  i2c_slave_init(SLAVE_I2C_ADDRESS);
+}
 
-void transport_slave_init(void) { i2c_slave_init(SLAVE_I2C_ADDRESS); }
+// The slave's I2C registers have no room for payloads
+int8_t split_payload_register(const split_payload_t *payload) { return -1; }
 
 #else  // USE_SERIAL
 
 #  include "serial.h"
+#  include "split_scheduler.h"
 
 typedef struct _Serial_s2m_buffer_t {
-  // TODO: if MATRIX_COLS > 8 change to uint8_t packed_matrix[] for pack/unpack
-  matrix_row_t smatrix[ROWS_PER_HAND];
+#  ifdef SPLIT_TRANSPORT_DELTA
+  // bytes that follow, only those are sent
+  uint8_t length;
+#  endif
 
 #  ifdef ENCODER_ENABLE
   uint8_t encoder_state[NUMBER_OF_ENCODERS];
 #  endif
 
+#  ifdef SPLIT_TRANSPORT_DELTA
+  split_delta_msg_t delta;
+#  else
+  uint8_t packed_matrix[ROWS_PER_HAND * SPLIT_ROW_BYTES];
+#  endif
 } Serial_s2m_buffer_t;
 
 typedef struct _Serial_m2s_buffer_t {
 #  ifdef BACKLIGHT_ENABLE
   uint8_t           backlight_level;
 #  endif
+#  ifdef SPLIT_TRANSPORT_DELTA
+  split_delta_ack_t delta_ack;
+#  endif
 } Serial_m2s_buffer_t;
 
 #if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
@@ -141,7 +264,24 @@ typedef struct _Serial_rgblight_t {
 } Serial_rgblight_t;
 
 volatile Serial_rgblight_t serial_rgblight = {};
-uint8_t volatile status_rgblight           = 0;
+
+#  define SPLIT_BUILTIN_PAYLOADS 1
+#else
+#  define SPLIT_BUILTIN_PAYLOADS 0
+#endif
+
+#ifndef SPLIT_TRANSPORT_PAYLOADS
+#  define SPLIT_TRANSPORT_PAYLOADS 0
+#endif
+
+#ifdef SERIAL_USE_MULTI_TRANSACTION
+#  define SPLIT_PAYLOADS_MAX (SPLIT_BUILTIN_PAYLOADS + SPLIT_TRANSPORT_PAYLOADS)
+#else
+#  define SPLIT_PAYLOADS_MAX 0
+#endif
+
+#if SPLIT_PAYLOADS_MAX > SPLIT_SCHEDULER_SLOTS
+#  error "Too many split payloads, raise SPLIT_SCHEDULER_SLOTS"
 #endif
 
 volatile Serial_s2m_buffer_t serial_s2m_buffer = {};
@@ -150,75 +290,248 @@ uint8_t volatile status0                       = 0;
 
 enum serial_transaction_id {
     GET_SLAVE_MATRIX = 0,
-#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
-    PUT_RGBLIGHT,
-#endif
+    // followed by one transaction per registered payload
+    FIRST_PAYLOAD,
 };
 
-SSTD_t transactions[] = {
+SSTD_t transactions[FIRST_PAYLOAD + SPLIT_PAYLOADS_MAX] = {
     [GET_SLAVE_MATRIX] = {
         (uint8_t *)&status0,
         sizeof(serial_m2s_buffer),
         (uint8_t *)&serial_m2s_buffer,
         sizeof(serial_s2m_buffer),
         (uint8_t *)&serial_s2m_buffer,
+#  ifdef SPLIT_TRANSPORT_DELTA
+        1, // length prefixed
+#  endif
     },
-#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
-    [PUT_RGBLIGHT] = {
-        (uint8_t *)&status_rgblight,
-        sizeof(serial_rgblight),
-        (uint8_t *)&serial_rgblight,
-        0, NULL // no slave to master transfer
-    },
-#endif
 };
 
-void transport_master_init(void) { soft_serial_initiator_init(transactions, TID_LIMIT(transactions)); }
+static bool transport_is_master;
+static bool transport_started;
 
-void transport_slave_init(void) { soft_serial_target_init(transactions, TID_LIMIT(transactions)); }
+static void transport_serial_init(void);
 
-#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+// Counts a finished transaction in the link statistics
+static bool transport_transaction_done(uint8_t tid, int status, uint16_t duration_us) {
+#ifdef SPLIT_LINK_STATS_ENABLE
+  SSTD_t *trans = &transactions[tid];
+  uint8_t bytes = trans->initiator2target_buffer_size;
+  if (trans->target2initiator_buffer_size > 0) {
+    uint8_t length = trans->target2initiator_buffer[0];
+    bytes += trans->target2initiator_length_prefixed && length < trans->target2initiator_buffer_size ? length + 1 : trans->target2initiator_buffer_size;
+  }
+  SPLIT_LINK_STATS_RECORD(tid, status == TRANSACTION_END ? SPLIT_LINK_OK : status == TRANSACTION_NO_RESPONSE ? SPLIT_LINK_NO_RESPONSE : SPLIT_LINK_DATA_ERROR, bytes, duration_us);
+#endif
+  return status == TRANSACTION_END;
+}
 
-// rgblight synchronization information communication.
+// Runs a transaction and counts it in the link statistics
+static bool transport_transaction(uint8_t tid, uint16_t *duration_us) {
+  uint32_t begin = timer_read_ticks();
+#ifndef SERIAL_USE_MULTI_TRANSACTION
+  int status = soft_serial_transaction();
+#else
+  int status = soft_serial_transaction(tid);
+#endif
+  *duration_us = timer_elapsed_us(begin);
+  return transport_transaction_done(tid, status, *duration_us);
+}
 
-void transport_rgblight_master(void) {
-  if (rgblight_get_change_flags()) {
-    rgblight_get_syncinfo((rgblight_syncinfo_t *)&serial_rgblight.rgblight_sync);
-    if (soft_serial_transaction(PUT_RGBLIGHT) == TRANSACTION_END) {
-        rgblight_clear_change_flags();
+#ifdef SERIAL_USART
+// The USART runs the matrix transaction from its interrupts: it is started
+// at the end of one scan and collected at the start of the next, so it
+// overlaps with the rest of the scan instead of blocking the master
+static bool matrix_started;
+
+static void transport_matrix_start(void) { matrix_started = serial_transaction_start(GET_SLAVE_MATRIX); }
+
+// duration_us is how long the master still had to wait for the answer
+static bool transport_matrix_collect(uint16_t *duration_us) {
+  if (!matrix_started) {
+    return transport_transaction(GET_SLAVE_MATRIX, duration_us);
+  }
+  uint32_t begin = timer_read_ticks();
+  int      status;
+  while ((status = serial_transaction_poll()) == TRANSACTION_BUSY) {
+  }
+  matrix_started = false;
+  *duration_us   = timer_elapsed_us(begin);
+  return transport_transaction_done(GET_SLAVE_MATRIX, status, *duration_us);
+}
+#else
+#  define transport_matrix_start()
+#  define transport_matrix_collect(duration_us) transport_transaction(GET_SLAVE_MATRIX, duration_us)
+#endif
+
+#if SPLIT_PAYLOADS_MAX > 0
+static split_payload_t  payloads[SPLIT_PAYLOADS_MAX];
+static volatile uint8_t payload_status[SPLIT_PAYLOADS_MAX];
+static uint8_t          payload_count;
+
+int8_t split_payload_register(const split_payload_t *payload) {
+  if (payload_count >= SPLIT_PAYLOADS_MAX) {
+    return -1;
+  }
+  // payloads are the only users of the scheduler, so their slots match
+  if (split_scheduler_add(payload->priority) < 0) {
+    return -1;
+  }
+  uint8_t id   = payload_count++;
+  payloads[id] = *payload;
+  transactions[FIRST_PAYLOAD + id] = (SSTD_t){
+      (uint8_t *)&payload_status[id],
+      payload->size,
+      payload->buffer,
+      0, NULL // no slave to master transfer
+  };
+  // let the serial driver know about the new transaction
+  if (transport_started) {
+    transport_serial_init();
+  }
+  return id;
+}
+
+// Refreshes the payloads and sends the pending ones that fit into what the
+// matrix left of SPLIT_TRANSPORT_BUDGET_US
+static void transport_payloads_master(uint32_t start) {
+  split_scheduler_begin_scan();
+  for (uint8_t i = 0; i < payload_count; i++) {
+    if (payloads[i].update(payloads[i].buffer)) {
+      split_scheduler_set_pending(i);
+    }
+  }
+
+  for (;;) {
+    uint32_t used      = timer_elapsed_us(start);
+    uint16_t remaining = used < SPLIT_TRANSPORT_BUDGET_US ? SPLIT_TRANSPORT_BUDGET_US - used : 0;
+    int8_t   slot      = split_scheduler_next(remaining);
+    if (slot < 0) {
+      break;
     }
+    uint16_t duration_us;
+    bool     ok = transport_transaction(FIRST_PAYLOAD + slot, &duration_us);
+    split_scheduler_done(slot, ok, duration_us);
   }
 }
 
-void transport_rgblight_slave(void) {
-  if (status_rgblight == TRANSACTION_ACCEPTED) {
-    rgblight_update_sync((rgblight_syncinfo_t *)&serial_rgblight.rgblight_sync,
-                         false);
-    status_rgblight = TRANSACTION_END;
+// Payloads can be registered before the transport starts, for example from
+// matrix_init_user(), so they get their slots back in the same order
+static void transport_payloads_init(void) {
+  split_scheduler_init();
+  for (uint8_t i = 0; i < payload_count; i++) {
+    split_scheduler_add(payloads[i].priority);
   }
 }
 
+static void transport_payloads_slave(void) {
+  for (uint8_t i = 0; i < payload_count; i++) {
+    if (payload_status[i] == TRANSACTION_ACCEPTED) {
+      payloads[i].receive(payloads[i].buffer);
+      payload_status[i] = TRANSACTION_END;
+    }
+  }
+}
 #else
-#define transport_rgblight_master()
-#define transport_rgblight_slave()
+#  define payload_count 0
+
+int8_t split_payload_register(const split_payload_t *payload) { return -1; }
+
+static inline void transport_payloads_init(void) {}
+static inline void transport_payloads_master(uint32_t start) {}
+static inline void transport_payloads_slave(void) {}
 #endif
 
-bool transport_master(matrix_row_t matrix[]) {
-#ifndef SERIAL_USE_MULTI_TRANSACTION
-  if (soft_serial_transaction() != TRANSACTION_END) {
+static void transport_serial_init(void) {
+#ifdef SERIAL_USART
+  // the driver forgets a transaction in progress
+  matrix_started = false;
+#endif
+  if (transport_is_master) {
+    soft_serial_initiator_init(transactions, FIRST_PAYLOAD + payload_count);
+  } else {
+    soft_serial_target_init(transactions, FIRST_PAYLOAD + payload_count);
+  }
+  transport_started = true;
+}
+
+#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+
+// rgblight synchronization information communication.
+
+static bool rgblight_payload_update(void *buffer) {
+  if (!rgblight_get_change_flags()) {
     return false;
   }
+  rgblight_get_syncinfo((rgblight_syncinfo_t *)buffer);
+  rgblight_clear_change_flags();
+  return true;
+}
+
+static void rgblight_payload_receive(const void *buffer) {
+  rgblight_update_sync((rgblight_syncinfo_t *)buffer, false);
+}
+
+static void transport_rgblight_register(void) {
+  split_payload_t payload = {
+    .buffer   = (void *)&serial_rgblight.rgblight_sync,
+    .size     = sizeof(serial_rgblight),
+    .priority = 0,
+    .update   = rgblight_payload_update,
+    .receive  = rgblight_payload_receive,
+  };
+  split_payload_register(&payload);
+}
 #else
-  transport_rgblight_master();
-  if (soft_serial_transaction(GET_SLAVE_MATRIX) != TRANSACTION_END) {
+#  define transport_rgblight_register()
+#endif
+
+void transport_master_init(void) {
+#  ifdef SPLIT_TRANSPORT_DELTA
+  split_delta_master_init(&delta_master, (split_delta_ack_t *)&serial_m2s_buffer.delta_ack);
+#  endif
+  transport_payloads_init();
+  transport_rgblight_register();
+  transport_is_master = true;
+  transport_serial_init();
+}
+
+void transport_slave_init(void) {
+#  ifdef SPLIT_TRANSPORT_DELTA
+  split_delta_slave_init(&delta_slave);
+  // send full copies until the master acknowledges one
+  serial_m2s_buffer.delta_ack.resync = 1;
+#  endif
+  transport_payloads_init();
+  transport_rgblight_register();
+  transport_is_master = false;
+  transport_serial_init();
+}
+
+bool transport_master(matrix_row_t matrix[]) {
+  // the matrix goes first, everything else shares what is left of the budget
+  uint32_t start = timer_read_ticks();
+  uint16_t duration_us;
+  if (!transport_matrix_collect(&duration_us)) {
+    transport_matrix_start();
     return false;
   }
-#endif
 
-  // TODO:  if MATRIX_COLS > 8 change to unpack()
-  for (int i = 0; i < ROWS_PER_HAND; ++i) {
-    matrix[i] = serial_s2m_buffer.smatrix[i];
+#  ifdef SPLIT_TRANSPORT_DELTA
+  uint8_t size = 0;
+  if (serial_s2m_buffer.length + 1 > offsetof(Serial_s2m_buffer_t, delta)) {
+    size = serial_s2m_buffer.length + 1 - offsetof(Serial_s2m_buffer_t, delta);
   }
+  bool ok = split_delta_master_apply(&delta_master, (split_delta_msg_t *)&serial_s2m_buffer.delta, size, (split_delta_ack_t *)&serial_m2s_buffer.delta_ack);
+  if (ok) {
+    memcpy(matrix, delta_master.matrix, sizeof(delta_master.matrix));
+  } else {
+    SPLIT_LINK_STATS_REJECT(GET_SLAVE_MATRIX);
+  }
+#  else
+  bool ok = true;
+  split_unpack_rows(matrix, (uint8_t *)serial_s2m_buffer.packed_matrix, ROWS_PER_HAND);
+#  endif
 
 #  ifdef BACKLIGHT_ENABLE
   // Write backlight level for slave to read
@@ -229,15 +542,19 @@ bool transport_master(matrix_row_t matrix[]) {
   encoder_update_raw((uint8_t *)serial_s2m_buffer.encoder_state);
 #  endif
 
-  return true;
+  transport_payloads_master(start);
+  transport_matrix_start();
+  return ok;
 }
 
 void transport_slave(matrix_row_t matrix[]) {
-  transport_rgblight_slave();
-  // TODO: if MATRIX_COLS > 8 change to pack()
-  for (int i = 0; i < ROWS_PER_HAND; ++i) {
-    serial_s2m_buffer.smatrix[i] = matrix[i];
-  }
+  transport_payloads_slave();
+#  ifdef SPLIT_TRANSPORT_DELTA
+  uint8_t size = split_delta_slave_update(&delta_slave, matrix, (split_delta_ack_t *)&serial_m2s_buffer.delta_ack, (split_delta_msg_t *)&serial_s2m_buffer.delta);
+  serial_s2m_buffer.length = offsetof(Serial_s2m_buffer_t, delta) - 1 + size;
+#  else
+  split_pack_rows((uint8_t *)serial_s2m_buffer.packed_matrix, matrix, ROWS_PER_HAND);
+#  endif
 #  ifdef BACKLIGHT_ENABLE
   backlight_set(serial_m2s_buffer.backlight_level);
 #  endif
@@ -8,3 +8,19 @@ void transport_slave_init(void);
 // returns false if valid data not received from slave
 bool transport_master(matrix_row_t matrix[]);
 void transport_slave(matrix_row_t matrix[]);
+
+typedef struct {
+  // Master: the data to send, slave: the data received
+  void *  buffer;
+  uint8_t size;
+  // Higher is sent first when the link is busy
+  uint8_t priority;
+  // Master: refreshes buffer, returns true if it has to be sent
+  bool (*update)(void *buffer);
+  // Slave: called from the main loop after buffer was received
+  void (*receive)(const void *buffer);
+} split_payload_t;
+
+// Adds a master to slave transfer, returns its id or -1 if there is no room.
+// Both halves have to register the same payloads in the same order.
+int8_t split_payload_register(const split_payload_t *payload);
@@ -0,0 +1,189 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Split transport over serial_link. Instead of the master polling the slave
+ * every scan, each half writes its state into a triple buffered object and
+ * serial_link sends it as a COBS encoded frame with a CRC-32 when it changes,
+ * and every SPLIT_LINK_KEEPALIVE ms so a lost frame is replaced. Neither half
+ * waits for the other, the frames are received into the triple buffers and
+ * read by the next scan.
+ */
+
+#include <string.h>
+
+#include "matrix.h"
+#include "quantum.h"
+#include "timer.h"
+#include "transport.h"
+
+#ifdef BACKLIGHT_ENABLE
+#  include "backlight.h"
+#endif
+
+#ifdef ENCODER_ENABLE
+#  include "encoder.h"
+#endif
+
+#include "matrix_delta.h"
+#include "split_stats.h"
+#include "serial_link_usart.h"
+#include "serial_link/protocol/byte_stuffer.h"
+#include "serial_link/protocol/frame_router.h"
+#include "serial_link/protocol/transport.h"
+
+#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+#  error "SPLIT_TRANSPORT = serial_link does not sync RGB Light, use the serial or I2C transport for RGBLIGHT_SPLIT"
+#endif
+
+// Interval at which an unchanged state is sent again
+#ifndef SPLIT_LINK_KEEPALIVE
+#  define SPLIT_LINK_KEEPALIVE 10
+#endif
+
+// The master treats the slave as gone when nothing arrived for this long
+#ifndef SPLIT_LINK_TIMEOUT
+#  define SPLIT_LINK_TIMEOUT 50
+#endif
+
+// Tells the objects apart in the link statistics
+enum serial_link_object_id {
+  SERIAL_LINK_SLAVE_STATE,
+  SERIAL_LINK_MASTER_STATE,
+};
+
+typedef struct {
+  uint8_t packed_matrix[ROWS_PER_HAND * SPLIT_ROW_BYTES];
+#ifdef ENCODER_ENABLE
+  uint8_t encoder_state[NUMBER_OF_ENCODERS];
+#endif
+} slave_state_t;
+
+typedef struct {
+  uint8_t backlight_level;
+} master_state_t;
+
+// A frame adds the object id, the router byte and the CRC
+_Static_assert(sizeof(slave_state_t) + 6 <= MAX_FRAME_SIZE, "The slave state does not fit into MAX_FRAME_SIZE");
+
+SLAVE_TO_MASTER_OBJECT(slave_state, slave_state_t);
+MASTER_TO_ALL_SLAVES_OBJECT(master_state, master_state_t);
+
+static remote_object_t *remote_objects[] = {
+    [SERIAL_LINK_SLAVE_STATE]  = REMOTE_OBJECT(slave_state),
+    [SERIAL_LINK_MASTER_STATE] = REMOTE_OBJECT(master_state),
+};
+
+// Last state each half wrote, and when
+static slave_state_t  slave_sent;
+static uint16_t       slave_sent_time;
+#ifdef BACKLIGHT_ENABLE
+static master_state_t master_sent;
+static uint16_t       master_sent_time;
+#endif
+
+// The master's copy of the slave state
+static slave_state_t slave_state;
+static uint16_t      slave_state_time;
+static bool          slave_connected;
+
+// Frames go straight to the USART from update_transport()
+void signal_data_written(void) {}
+
+static void transport_serial_link_init(bool master) {
+  router_set_master(master);
+  init_byte_stuffer();
+  reinitialize_serial_link_transport();
+  add_remote_objects(remote_objects, sizeof(remote_objects) / sizeof(remote_objects[0]));
+  serial_link_usart_init(master ? DOWN_LINK : UP_LINK);
+
+  // the first scan sends the state of both halves
+  uint16_t now     = timer_read();
+  slave_sent_time  = now - SPLIT_LINK_KEEPALIVE;
+  slave_state_time = now;
+#ifdef BACKLIGHT_ENABLE
+  master_sent_time = now - SPLIT_LINK_KEEPALIVE;
+#endif
+}
+
+void transport_master_init(void) { transport_serial_link_init(true); }
+
+void transport_slave_init(void) { transport_serial_link_init(false); }
+
+bool transport_master(matrix_row_t matrix[]) {
+  // the master's side of the exchange: decoding the bytes and reading the frame
+  uint32_t start = timer_read_ticks();
+  serial_link_usart_receive();
+
+  slave_state_t *received = read_slave_state(0);
+  if (received) {
+    slave_state      = *received;
+    slave_state_time = timer_read();
+    slave_connected  = true;
+    SPLIT_LINK_STATS_RECORD(SERIAL_LINK_SLAVE_STATE, SPLIT_LINK_OK, sizeof(slave_state_t), timer_elapsed_us(start));
+#ifdef ENCODER_ENABLE
+    encoder_update_raw(slave_state.encoder_state);
+#endif
+  }
+
+#ifdef BACKLIGHT_ENABLE
+  uint8_t level = is_backlight_enabled() ? get_backlight_level() : 0;
+  if (level != master_sent.backlight_level || timer_elapsed(master_sent_time) >= SPLIT_LINK_KEEPALIVE) {
+    master_state_t *state = begin_write_master_state();
+    state->backlight_level = master_sent.backlight_level = level;
+    end_write_master_state();
+    master_sent_time = timer_read();
+  }
+#endif
+  update_transport();
+
+  if (timer_elapsed(slave_state_time) > SPLIT_LINK_TIMEOUT) {
+    if (slave_connected) {
+      slave_connected = false;
+      SPLIT_LINK_STATS_RECORD(SERIAL_LINK_SLAVE_STATE, SPLIT_LINK_NO_RESPONSE, 0, 0);
+    }
+    return false;
+  }
+  // written every scan, matrix.c clears it when the slave is gone
+  split_unpack_rows(matrix, slave_state.packed_matrix, ROWS_PER_HAND);
+  return true;
+}
+
+void transport_slave(matrix_row_t matrix[]) {
+  serial_link_usart_receive();
+
+  slave_state_t state;
+  split_pack_rows(state.packed_matrix, matrix, ROWS_PER_HAND);
+#ifdef ENCODER_ENABLE
+  encoder_state_raw(state.encoder_state);
+#endif
+  if (memcmp(&state, &slave_sent, sizeof(state)) != 0 || timer_elapsed(slave_sent_time) >= SPLIT_LINK_KEEPALIVE) {
+    *begin_write_slave_state() = slave_sent = state;
+    end_write_slave_state();
+    slave_sent_time = timer_read();
+  }
+  update_transport();
+
+#ifdef BACKLIGHT_ENABLE
+  master_state_t *received = read_master_state();
+  if (received) {
+    backlight_set(received->backlight_level);
+  }
+#endif
+}
+
+// Only the matrix, encoders and backlight have objects
+int8_t split_payload_register(const split_payload_t *payload) { return -1; }
@@ -18,6 +18,7 @@
 
 using testing::_;
 using testing::Return;
+using testing::AnyNumber;
 
 class ActionLayer : public TestFixture {};
 
@@ -90,3 +91,39 @@ TEST_F(ActionLayer, LayerStateCmp) {
 //     layer_off(2);
 //     EXPECT_EQ(layer_state, 0b1000);
 // }
+
+TEST_F(ActionLayer, SourceLayersCacheRoundTripsEveryLayer) {
+    for (uint8_t layer = 0; layer < 32; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                // Give every key a different layer so neighbours can't leak into each other
+                update_source_layers_cache((keypos_t){ .col = col, .row = row }, (layer + row * MATRIX_COLS + col) % 32);
+            }
+        }
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                EXPECT_EQ(read_source_layers_cache((keypos_t){ .col = col, .row = row }), (layer + row * MATRIX_COLS + col) % 32);
+            }
+        }
+    }
+}
+
+TEST_F(ActionLayer, KeyIsReleasedOnTheLayerItWasPressedOn) {
+    TestDriver driver;
+    press_key(0, 2);
+    // Switching layers clears the report
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    press_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Z)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    release_key(0, 2);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Z))).Times(AnyNumber());
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
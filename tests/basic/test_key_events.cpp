@@ -0,0 +1,103 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+using testing::Invoke;
+
+// Row 1 holds eight plain keys, KC_E to KC_L
+class KeyEvents : public TestFixture {
+protected:
+    unsigned reports = 0;
+
+    // Scan until `events` reports have been sent, returns the number of scans it took
+    unsigned scans_until_reported(unsigned events) {
+        unsigned scans = 0;
+        reports = 0;
+        while (reports < events && scans < events * 2) {
+            run_one_scan_loop();
+            scans++;
+        }
+        return scans;
+    }
+
+    // Roll `keys` keys, with `keys_per_scan` presses (and releases of the keys
+    // pressed one step earlier) landing between two consecutive scans
+    double roll(TestDriver& driver, uint8_t keys, uint8_t keys_per_scan) {
+        unsigned scans = 0;
+        EXPECT_CALL(driver, send_keyboard_mock(_))
+            .WillRepeatedly(Invoke([this](report_keyboard_t&) { reports++; }));
+        for (uint8_t first = 0; first <= keys; first += keys_per_scan) {
+            unsigned events = 0;
+            for (uint8_t col = first; col < first + keys_per_scan && col < keys; col++) {
+                press_key(col, 1);
+                events++;
+            }
+            for (uint8_t col = first - keys_per_scan; first > 0 && col < first; col++) {
+                release_key(col, 1);
+                events++;
+            }
+            scans += scans_until_reported(events);
+        }
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return double(scans) / double(keys * 2);
+    }
+};
+
+TEST_F(KeyEvents, AllChangedKeysAreProcessedInTheSameScan) {
+    TestDriver driver;
+    InSequence s;
+    press_key(0, 1);
+    press_key(1, 1);
+    press_key(2, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E, KC_F)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E, KC_F, KC_G)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    release_key(0, 1);
+    release_key(1, 1);
+    release_key(2, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F, KC_G)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_G)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(KeyEvents, FourKeyRollTakesOneScanPerBatch) {
+    TestDriver driver;
+    double scans_per_event = roll(driver, 4, 4);
+    RecordProperty("scan_cycles_per_event_x1000", int(scans_per_event * 1000));
+    // Four presses in one scan, four releases in the next
+    EXPECT_DOUBLE_EQ(scans_per_event, 2.0 / 8);
+}
+
+TEST_F(KeyEvents, EightKeyRollTakesOneScanPerBatch) {
+    TestDriver driver;
+    double scans_per_event = roll(driver, 8, 4);
+    RecordProperty("scan_cycles_per_event_x1000", int(scans_per_event * 1000));
+    // Presses of the second half land in the same scan as releases of the first
+    EXPECT_DOUBLE_EQ(scans_per_event, 3.0 / 16);
+}
+
+TEST_F(KeyEvents, SlowEightKeyRollTakesOneScanPerStep) {
+    TestDriver driver;
+    double scans_per_event = roll(driver, 8, 1);
+    RecordProperty("scan_cycles_per_event_x1000", int(scans_per_event * 1000));
+    EXPECT_DOUBLE_EQ(scans_per_event, 9.0 / 16);
+}
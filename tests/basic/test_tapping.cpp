@@ -95,3 +95,25 @@ TEST_F(Tapping, ANewTapWithinTappingTermIsBuggy) {
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT))).Times(1);
     idle_for(TAPPING_TERM);
 }
+
+TEST_F(Tapping, TypingAKeyDuringOtherTapKeyWaitsForTheRelease) {
+    TestDriver driver;
+    InSequence s;
+
+    press_key(7, 0);
+    run_one_scan_loop();
+    press_key(0, 0);
+    run_one_scan_loop();
+    release_key(0, 0);
+    // SFT_T(KC_P) is not a permissive hold key, so nothing is decided yet
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(TAPPING_TERM / 2);
+    release_key(7, 0);
+    // The release settles the interrupted mod tap as a hold, and everything
+    // buffered goes out in the same scan instead of after TAPPING_TERM
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT, KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
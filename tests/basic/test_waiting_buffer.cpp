@@ -0,0 +1,148 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include <vector>
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+struct KeyPos {
+    uint8_t col;
+    uint8_t row;
+    uint8_t code;
+};
+
+// Every plain key of the basic keymap
+const KeyPos letters[] = {
+    {0, 0, KC_A}, {1, 0, KC_B}, {0, 1, KC_E}, {1, 1, KC_F}, {2, 1, KC_G}, {3, 1, KC_H},
+    {4, 1, KC_I}, {5, 1, KC_J}, {6, 1, KC_K}, {7, 1, KC_L}, {0, 3, KC_C}, {1, 3, KC_D},
+};
+const size_t num_letters = sizeof(letters) / sizeof(letters[0]);
+
+bool report_has_key(const report_keyboard_t& report, uint8_t code) {
+    for (size_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == code) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+// Bursts of 32 key events while a tap key is held overflow the default
+// buffer. The tap key is then settled as a hold, and no event is lost.
+class WaitingBuffer : public TestFixture {
+   protected:
+    struct Press {
+        uint8_t code;
+        uint8_t mods;
+    };
+    std::vector<Press> presses;
+    report_keyboard_t  last = {};
+
+    // Records every key that goes from up to down in the reports
+    void record(TestDriver& driver) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t& report) {
+            for (size_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                if (report.keys[i] && !report_has_key(last, report.keys[i])) {
+                    presses.push_back({report.keys[i], report.mods});
+                }
+            }
+            last = report;
+        }));
+    }
+};
+
+TEST_F(WaitingBuffer, RollOfThirtyTwoEventsIsNotDropped) {
+    TestDriver driver;
+    record(driver);
+
+    press_key(7, 0);
+    run_one_scan_loop();
+    for (size_t i = 0; i < 16; i++) {
+        const KeyPos& key = letters[i % num_letters];
+        press_key(key.col, key.row);
+        run_one_scan_loop();
+        release_key(key.col, key.row);
+        run_one_scan_loop();
+    }
+    // the overflow settled the hold, well within TAPPING_TERM
+    EXPECT_EQ(last.mods, MOD_BIT(KC_LSFT));
+    release_key(7, 0);
+    run_one_scan_loop();
+
+    ASSERT_EQ(presses.size(), 16u);
+    for (size_t i = 0; i < 16; i++) {
+        EXPECT_EQ(presses[i].code, letters[i % num_letters].code);
+        EXPECT_EQ(presses[i].mods, MOD_BIT(KC_LSFT));
+    }
+    EXPECT_EQ(last.mods, 0);
+    EXPECT_FALSE(report_has_key(last, KC_A));
+}
+
+TEST_F(WaitingBuffer, BurstsOfThirtyTwoEventsAreNotDropped) {
+    TestDriver driver;
+    record(driver);
+
+    press_key(7, 0);
+    run_one_scan_loop();
+    // four keys go down in one scan and up in the next
+    for (size_t round = 0; round < 4; round++) {
+        for (size_t i = 0; i < 4; i++) {
+            const KeyPos& key = letters[(round * 4 + i) % num_letters];
+            press_key(key.col, key.row);
+        }
+        run_one_scan_loop();
+        for (size_t i = 0; i < 4; i++) {
+            const KeyPos& key = letters[(round * 4 + i) % num_letters];
+            release_key(key.col, key.row);
+        }
+        run_one_scan_loop();
+    }
+    release_key(7, 0);
+    run_one_scan_loop();
+
+    ASSERT_EQ(presses.size(), 16u);
+    for (size_t i = 0; i < 16; i++) {
+        EXPECT_EQ(presses[i].code, letters[i % num_letters].code);
+        EXPECT_EQ(presses[i].mods, MOD_BIT(KC_LSFT));
+    }
+    EXPECT_EQ(last.mods, 0);
+}
+
+TEST_F(WaitingBuffer, EventsThatFitAreStillHeldBack) {
+    TestDriver driver;
+    record(driver);
+
+    press_key(7, 0);
+    run_one_scan_loop();
+    // three taps are six events, which fit in the default buffer
+    for (size_t i = 0; i < 3; i++) {
+        press_key(letters[i].col, letters[i].row);
+        run_one_scan_loop();
+        release_key(letters[i].col, letters[i].row);
+        run_one_scan_loop();
+    }
+    EXPECT_TRUE(presses.empty());
+    release_key(7, 0);
+    run_one_scan_loop();
+
+    ASSERT_EQ(presses.size(), 3u);
+    EXPECT_EQ(last.mods, 0);
+}
@@ -0,0 +1,73 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "quantum.h"
+
+// Rows 0 and 1 hold the combo keys, row 3 keys are in no combo
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {KC_A,  KC_B,  KC_C,  KC_D,  KC_E,  KC_F,  KC_G,  KC_H,  KC_I,  KC_J},
+        {KC_K,  KC_L,  KC_M,  KC_N,  KC_O,  KC_P,  KC_Q,  KC_R,  KC_S,  KC_T},
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+        {KC_1,  KC_2,  KC_3,  KC_4,  KC_5,  KC_6,  KC_7,  KC_8,  KC_9,  KC_0},
+    },
+};
+
+// Generated combo table:
+//  0 - 99   every pair of one row 0 key and one row 1 key
+//  100 - 126 triples of row 0 keys
+//  127       A K L, overlapping the pairs A K and A L
+static uint16_t combo_keys[COMBO_COUNT][4];
+// Empty until keyboard_post_init_user(), the index is built before it runs
+static const uint16_t no_keys[] = {COMBO_END};
+combo_t key_combos[COMBO_COUNT] = {[0 ... COMBO_COUNT - 1] = COMBO_ACTION(no_keys)};
+
+void keyboard_post_init_user(void) {
+    uint8_t n = 0;
+    for (; n < 100; n++) {
+        combo_keys[n][0] = KC_A + n % 10;
+        combo_keys[n][1] = KC_K + n / 10;
+        combo_keys[n][2] = COMBO_END;
+    }
+    for (uint8_t i = 0; i < 10 && n < COMBO_COUNT - 1; i++) {
+        for (uint8_t j = i + 1; j < 10 && n < COMBO_COUNT - 1; j++) {
+            for (uint8_t k = j + 1; k < 10 && n < COMBO_COUNT - 1; k++, n++) {
+                combo_keys[n][0] = KC_A + i;
+                combo_keys[n][1] = KC_A + j;
+                combo_keys[n][2] = KC_A + k;
+                combo_keys[n][3] = COMBO_END;
+            }
+        }
+    }
+    combo_keys[n][0] = KC_A;
+    combo_keys[n][1] = KC_K;
+    combo_keys[n][2] = KC_L;
+    combo_keys[n][3] = COMBO_END;
+    for (n = 0; n < COMBO_COUNT; n++) {
+        key_combos[n] = (combo_t)COMBO_ACTION(combo_keys[n]);
+    }
+    key_combos[0].keycode = KC_ESC;
+    combo_index_invalidate();
+}
+
+uint16_t get_combo_term(uint8_t combo_index, combo_t *combo) {
+    return combo_index == COMBO_COUNT - 1 ? COMBO_TERM * 2 : COMBO_TERM;
+}
+
+// Lets a test keep key presses away from the combos, their releases still get there
+bool keymap_takes_presses = false;
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) { return !(keymap_takes_presses && record->event.pressed); }
@@ -0,0 +1,333 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <utility>
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+extern "C" combo_t key_combos[COMBO_COUNT];
+extern "C" bool    keymap_takes_presses;
+
+static std::vector<std::pair<uint8_t, bool>> combo_events;
+
+extern "C" void process_combo_event(uint8_t combo_index, bool pressed) {
+    combo_events.push_back(std::make_pair(combo_index, pressed));
+}
+
+class Combo : public TestFixture {
+public:
+    Combo() {
+        // A key in no combo resolves any keys an earlier test left buffered
+        TestDriver driver;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        press_key(9, 3);
+        run_one_scan_loop();
+        release_key(9, 3);
+        run_one_scan_loop();
+        combo_events.clear();
+    }
+};
+
+TEST_F(Combo, PairWithKeycodeIsReported) {
+    TestDriver driver;
+    InSequence s;
+    // B K is combo 1, give it the keycode of combo 0 for this test
+    key_combos[1].keycode = KC_ESC;
+    press_key(1, 0);
+    press_key(0, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_ESC)));
+    run_one_scan_loop();
+    // The first release ends the combo, the combo keys are consumed until released
+    release_key(1, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    release_key(0, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    key_combos[1].keycode = 0;
+    EXPECT_TRUE(combo_events.empty());
+}
+
+TEST_F(Combo, EveryGeneratedPairFiresItsOwnAction) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    for (uint8_t n = 1; n < 100; n++) {
+        combo_events.clear();
+        press_key(n % 10, 0);
+        run_one_scan_loop();
+        press_key(n / 10, 1);
+        run_one_scan_loop();
+        release_key(n % 10, 0);
+        release_key(n / 10, 1);
+        run_one_scan_loop();
+        ASSERT_EQ(combo_events.size(), 2u) << "combo " << int(n);
+        EXPECT_EQ(combo_events[0], std::make_pair(n, true));
+        EXPECT_EQ(combo_events[1], std::make_pair(n, false));
+    }
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, TripleFiresOnTheLastKey) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    press_key(0, 0);
+    press_key(1, 0);
+    run_one_scan_loop();
+    EXPECT_TRUE(combo_events.empty());
+    press_key(3, 0);
+    run_one_scan_loop();
+    ASSERT_EQ(combo_events.size(), 1u);
+    EXPECT_EQ(combo_events[0], std::make_pair(uint8_t(101), true));
+    release_key(0, 0);
+    release_key(1, 0);
+    release_key(3, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    run_one_scan_loop();
+    ASSERT_EQ(combo_events.size(), 2u);
+    EXPECT_EQ(combo_events[1], std::make_pair(uint8_t(101), false));
+}
+
+TEST_F(Combo, KeyInNoComboIsReportedRightAway) {
+    TestDriver driver;
+    InSequence s;
+    press_key(0, 3);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_1)));
+    run_one_scan_loop();
+    release_key(0, 3);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(Combo, LoneComboKeyIsReportedAfterComboTerm) {
+    TestDriver driver;
+    InSequence s;
+    press_key(4, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(COMBO_TERM);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    idle_for(2);
+    release_key(4, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    EXPECT_TRUE(combo_events.empty());
+}
+
+TEST_F(Combo, ComboKeyIsFlushedByKeyInNoCombo) {
+    TestDriver driver;
+    InSequence s;
+    press_key(4, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    press_key(0, 3);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E, KC_1)));
+    run_one_scan_loop();
+    release_key(4, 0);
+    release_key(0, 3);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_1)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    EXPECT_TRUE(combo_events.empty());
+}
+
+TEST_F(Combo, LongestOverlappingComboWins) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    press_key(0, 0);
+    press_key(0, 1);
+    run_one_scan_loop();
+    // A K is complete, but A K L can still match
+    EXPECT_TRUE(combo_events.empty());
+    press_key(1, 1);
+    run_one_scan_loop();
+    ASSERT_EQ(combo_events.size(), 1u);
+    EXPECT_EQ(combo_events[0], std::make_pair(uint8_t(COMBO_COUNT - 1), true));
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, ShorterComboFiresWhenTheLongerOneTimesOut) {
+    TestDriver driver;
+    InSequence s;
+    press_key(0, 0);
+    press_key(0, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    // A K L has twice the term of A K
+    idle_for(COMBO_TERM * 2 - 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_ESC)));
+    idle_for(2);
+    release_key(0, 0);
+    release_key(0, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(Combo, ShorterComboFiresWhenAKeyIsReleased) {
+    TestDriver driver;
+    InSequence s;
+    press_key(0, 0);
+    press_key(0, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    release_key(0, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_ESC)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+}
+
+TEST_F(Combo, ShorterComboFiresBeforeAnInterruptingKey) {
+    TestDriver driver;
+    InSequence s;
+    press_key(0, 0);
+    press_key(0, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    press_key(0, 3);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_ESC)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_ESC, KC_1)));
+    run_one_scan_loop();
+}
+
+TEST_F(Combo, KeysThatCanNoLongerMatchAreReleasedRightAway) {
+    TestDriver driver;
+    InSequence s;
+    press_key(0, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    // No combo holds both K and N, K goes out without waiting for its term
+    press_key(3, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_K)));
+    run_one_scan_loop();
+    // N is still waiting for a row 0 key
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(COMBO_TERM - 2);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_K, KC_N)));
+    idle_for(3);
+    EXPECT_TRUE(combo_events.empty());
+}
+
+TEST_F(Combo, TappedComboKeyIsReportedOnRelease) {
+    TestDriver driver;
+    InSequence s;
+    press_key(4, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    release_key(4, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(Combo, OverlappingCombosAreHeldTogether) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    press_key(1, 0);
+    press_key(0, 1);
+    run_one_scan_loop();
+    press_key(2, 0);
+    press_key(1, 1);
+    run_one_scan_loop();
+    release_key(1, 0);
+    release_key(2, 0);
+    run_one_scan_loop();
+    release_key(0, 1);
+    release_key(1, 1);
+    run_one_scan_loop();
+    ASSERT_EQ(combo_events.size(), 4u);
+    EXPECT_EQ(combo_events[0], std::make_pair(uint8_t(1), true));
+    EXPECT_EQ(combo_events[1], std::make_pair(uint8_t(12), true));
+    EXPECT_EQ(combo_events[2], std::make_pair(uint8_t(1), false));
+    EXPECT_EQ(combo_events[3], std::make_pair(uint8_t(12), false));
+}
+
+TEST_F(Combo, ReleaseWithoutItsPressKeepsCombosArmed) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    // The keymap takes the press of A, only its release reaches the combos
+    keymap_takes_presses = true;
+    press_key(0, 0);
+    run_one_scan_loop();
+    keymap_takes_presses = false;
+    release_key(0, 0);
+    run_one_scan_loop();
+
+    // A lone combo key outlasts the term, a key in no combo arms them again
+    press_key(4, 0);
+    idle_for(COMBO_TERM + 2);
+    release_key(4, 0);
+    run_one_scan_loop();
+    press_key(0, 3);
+    run_one_scan_loop();
+    release_key(0, 3);
+    run_one_scan_loop();
+
+    combo_events.clear();
+    press_key(1, 0);
+    press_key(1, 1);
+    run_one_scan_loop();
+    release_key(1, 0);
+    release_key(1, 1);
+    run_one_scan_loop();
+    ASSERT_EQ(combo_events.size(), 2u);
+    EXPECT_EQ(combo_events[0], std::make_pair(uint8_t(11), true));
+    EXPECT_EQ(combo_events[1], std::make_pair(uint8_t(11), false));
+}
+
+// The lookup every event paid for before the keycode index: walk every combo
+static uint8_t linear_combo_lookup(uint16_t keycode) {
+    uint8_t found = 0;
+    for (uint8_t c = 0; c < COMBO_COUNT; c++) {
+        for (const uint16_t *keys = key_combos[c].keys;; keys++) {
+            uint16_t key = pgm_read_word(keys);
+            if (key == keycode) found++;
+            if (key == COMBO_END) break;
+        }
+    }
+    return found;
+}
+
+TEST_F(Combo, PerEventCostBenchmark) {
+    const unsigned rounds = 20000;
+    keyrecord_t record = {};
+    volatile uint8_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < rounds; i++) {
+        sink = linear_combo_lookup(KC_1);
+    }
+    std::chrono::duration<double, std::micro> linear = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < rounds; i++) {
+        record.event.pressed = i & 1;
+        sink = process_combo(KC_1, &record);
+    }
+    std::chrono::duration<double, std::micro> indexed = std::chrono::steady_clock::now() - start;
+    (void)sink;
+
+    printf("%d combos, us/event for a key in no combo: linear lookup %.4f, process_combo %.4f\n",
+        COMBO_COUNT, linear.count() / rounds, indexed.count() / rounds);
+    RecordProperty("linear_lookup_ns_per_event", int(linear.count() * 1000 / rounds));
+    RecordProperty("process_combo_ns_per_event", int(indexed.count() * 1000 / rounds));
+}
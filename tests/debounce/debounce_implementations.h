@@ -0,0 +1,48 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "matrix.h"
+
+/* Every quantum/debounce algorithm, as X(name, eager_press, eager_release).
+ *
+ * Each one is compiled by tests/debounce/debounce_<name>.c, which renames its
+ * entry points to <entry point>_<name> so they can all be linked together.
+ * Eager algorithms push the first edge of a change right away, so they let
+ * noise spikes through by design.
+ */
+#define DEBOUNCE_IMPLEMENTATIONS(X)           \
+    X(sym_g, false, false)                    \
+    X(sym_pk, false, false)                   \
+    X(sym_pr, false, false)                   \
+    X(eager_pk, true, true)                   \
+    X(eager_pr, true, true)                   \
+    X(asym_eager_defer_pk, true, false)
+
+#define DEBOUNCE_DECLARE(name, eager_press, eager_release)                                                   \
+    void debounce_init_##name(uint8_t num_rows);                                                             \
+    void debounce_##name(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+DEBOUNCE_IMPLEMENTATIONS(DEBOUNCE_DECLARE)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,23 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define debounce debounce_sym_g
+#define debounce_init debounce_init_sym_g
+#define debounce_active debounce_active_sym_g
+#define update_debounce_counters update_debounce_counters_sym_g
+#define transfer_matrix_values transfer_matrix_values_sym_g
+
+#include "debounce/sym_g.c"
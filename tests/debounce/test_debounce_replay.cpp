@@ -0,0 +1,329 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Replays contact bounce traces through every debounce algorithm, and reports
+ * the latency each one adds to every press and release, and the chatter it
+ * lets through.
+ *
+ * Set QMK_DEBOUNCE_TRACE to a list of files, separated by ':', to replay
+ * recorded traces as well. A trace file has one "<time in us> <0 or 1>" line
+ * per edge of the switch at row 0, column 0, '#' starts a comment.
+ * Set QMK_DEBOUNCE_VERBOSE to print every single event.
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "quantum.h"
+#include "debounce_implementations.h"
+void set_time(uint32_t t);
+}
+
+namespace {
+
+// Time between two matrix scans
+const uint32_t SCAN_PERIOD_US = 250;
+// Quiet time that separates two bursts of edges
+const uint32_t SETTLE_US = 10000;
+
+struct Edge {
+    uint32_t time_us;
+    bool     pressed;
+};
+
+struct KeyEdges {
+    uint8_t           row;
+    uint8_t           col;
+    std::vector<Edge> edges;
+};
+
+struct BounceTrace {
+    std::string           name;
+    std::vector<KeyEdges> keys;
+    uint32_t              max_bounce_us;
+    // latencies only have a bound when keys don't interfere with each other
+    bool check_latency;
+};
+
+struct Implementation {
+    const char* name;
+    void (*init)(uint8_t num_rows);
+    void (*debounce)(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+    bool eager_press;
+    bool eager_release;
+};
+
+#define DEBOUNCE_ENTRY(name, eager_press, eager_release) {#name, debounce_init_##name, debounce_##name, eager_press, eager_release},
+const Implementation implementations[] = {DEBOUNCE_IMPLEMENTATIONS(DEBOUNCE_ENTRY)};
+
+// Small deterministic generator, so every run replays the same traces
+class Random {
+   public:
+    explicit Random(uint32_t seed) : state(seed) {}
+    uint32_t next(uint32_t min, uint32_t max) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return min + state % (max - min + 1);
+    }
+
+   private:
+    uint32_t state;
+};
+
+// The switch settles on pressed after up to bounces spikes in bounce_us
+void add_burst(std::vector<Edge>& edges, Random& random, uint32_t time_us, bool pressed, uint8_t bounces, uint32_t bounce_us) {
+    edges.push_back({time_us, pressed});
+    uint8_t                toggles = 2 * random.next(0, bounces);
+    std::vector<uint32_t> times;
+    for (uint8_t i = 0; i < toggles; i++) {
+        times.push_back(random.next(1, bounce_us - toggles));
+    }
+    std::sort(times.begin(), times.end());
+    for (uint8_t i = 0; i < toggles; i++) {
+        edges.push_back({time_us + times[i] + i, (i % 2) ? pressed : !pressed});
+    }
+}
+
+KeyEdges synthetic_key(uint8_t col, uint32_t seed, uint32_t start_us, uint8_t bounces, uint32_t bounce_us, bool noise) {
+    Random   random(seed);
+    KeyEdges key = {0, col, {}};
+    uint32_t t   = start_us;
+    for (int cycle = 0; cycle < 20; cycle++) {
+        uint32_t hold = random.next(40000, 120000);
+        add_burst(key.edges, random, t, true, bounces, bounce_us);
+        if (noise) {
+            uint32_t spike = t + hold / 2;
+            key.edges.push_back({spike, false});
+            key.edges.push_back({spike + random.next(100, 900), true});
+        }
+        t += hold;
+
+        uint32_t gap = random.next(40000, 120000);
+        add_burst(key.edges, random, t, false, bounces, bounce_us);
+        if (noise) {
+            uint32_t spike = t + gap / 2;
+            key.edges.push_back({spike, true});
+            key.edges.push_back({spike + random.next(100, 900), false});
+        }
+        t += gap;
+    }
+    return key;
+}
+
+std::vector<BounceTrace> synthetic_traces() {
+    std::vector<BounceTrace> traces;
+    traces.push_back({"clean", {synthetic_key(0, 1, 1000, 0, 1, false)}, 0, true});
+    traces.push_back({"bounce_1ms", {synthetic_key(0, 2, 1000, 3, 1000, false)}, 1000, true});
+    traces.push_back({"bounce_4ms", {synthetic_key(0, 3, 1000, 6, 4000, false)}, 4000, true});
+    traces.push_back({"noise", {synthetic_key(0, 4, 1000, 3, 1000, true)}, 1000, true});
+    // two keys of the same row, pressed and released a few ms apart
+    traces.push_back({"roll", {synthetic_key(0, 5, 1000, 3, 2000, false), synthetic_key(1, 5, 4000, 3, 2000, false)}, 2000, false});
+    return traces;
+}
+
+std::vector<BounceTrace> recorded_traces() {
+    std::vector<BounceTrace> traces;
+    const char*              list = getenv("QMK_DEBOUNCE_TRACE");
+    if (!list) {
+        return traces;
+    }
+
+    std::stringstream files(list);
+    std::string       path;
+    while (std::getline(files, path, ':')) {
+        std::ifstream file(path);
+        if (!file) {
+            ADD_FAILURE() << "Can't open trace " << path;
+            continue;
+        }
+        KeyEdges    key = {0, 0, {}};
+        std::string line;
+        while (std::getline(file, line)) {
+            line = line.substr(0, line.find('#'));
+            std::stringstream fields(line);
+            uint32_t          time_us;
+            int               level;
+            if (fields >> time_us >> level) {
+                key.edges.push_back({time_us, level != 0});
+            }
+        }
+        traces.push_back({path, {key}, 0, false});
+    }
+    return traces;
+}
+
+struct Transition {
+    uint32_t time_us;
+    bool     pressed;
+};
+
+// A change of the key: the first edge of a burst that settles on a new level
+std::vector<Transition> key_changes(const KeyEdges& key) {
+    std::vector<Transition> changes;
+    bool                    level = false;
+    for (size_t i = 0; i < key.edges.size();) {
+        size_t end = i + 1;
+        while (end < key.edges.size() && key.edges[end].time_us - key.edges[end - 1].time_us < SETTLE_US) {
+            end++;
+        }
+        bool settled = key.edges[end - 1].pressed;
+        if (settled != level) {
+            changes.push_back({key.edges[i].time_us, settled});
+            level = settled;
+        }
+        i = end;
+    }
+    return changes;
+}
+
+struct Result {
+    std::vector<uint32_t> press_latency_us;
+    std::vector<uint32_t> release_latency_us;
+    unsigned              chatter = 0;
+    unsigned              missed  = 0;
+};
+
+void replay(const Implementation& implementation, const BounceTrace& trace, Result& result) {
+    static uint32_t now_us = 0;
+    // keep the clock running between traces, state left in the algorithm stays valid
+    uint32_t start_us = now_us;
+    uint32_t end_us   = 0;
+    for (auto& key : trace.keys) {
+        if (!key.edges.empty()) {
+            end_us = std::max(end_us, key.edges.back().time_us + SETTLE_US * 2);
+        }
+    }
+
+    matrix_row_t raw[MATRIX_ROWS]    = {};
+    matrix_row_t cooked[MATRIX_ROWS] = {};
+    set_time(start_us / 1000);
+    implementation.init(MATRIX_ROWS);
+
+    std::vector<size_t>                  next_edge(trace.keys.size(), 0);
+    std::vector<std::vector<Transition>> output(trace.keys.size());
+    for (uint32_t t = 0; t <= end_us; t += SCAN_PERIOD_US) {
+        set_time((start_us + t) / 1000);
+        bool changed = false;
+        for (size_t k = 0; k < trace.keys.size(); k++) {
+            auto& key = trace.keys[k];
+            for (; next_edge[k] < key.edges.size() && key.edges[next_edge[k]].time_us <= t; next_edge[k]++) {
+                matrix_row_t mask = (matrix_row_t)1 << key.col;
+                matrix_row_t row  = key.edges[next_edge[k]].pressed ? (raw[key.row] | mask) : (raw[key.row] & ~mask);
+                changed |= row != raw[key.row];
+                raw[key.row] = row;
+            }
+        }
+
+        implementation.debounce(raw, cooked, MATRIX_ROWS, changed);
+
+        for (size_t k = 0; k < trace.keys.size(); k++) {
+            auto& key    = trace.keys[k];
+            bool  state  = cooked[key.row] & ((matrix_row_t)1 << key.col);
+            bool  before = output[k].empty() ? false : output[k].back().pressed;
+            if (state != before) {
+                output[k].push_back({t, state});
+            }
+        }
+    }
+    now_us = start_us + end_us + SCAN_PERIOD_US;
+
+    // every change is expected once, between itself and the next change
+    bool verbose = getenv("QMK_DEBOUNCE_VERBOSE") != nullptr;
+    for (size_t k = 0; k < trace.keys.size(); k++) {
+        auto   changes = key_changes(trace.keys[k]);
+        auto&  pushed  = output[k];
+        size_t next    = 0;
+        for (size_t c = 0; c < changes.size(); c++) {
+            uint32_t until = c + 1 < changes.size() ? changes[c + 1].time_us : UINT32_MAX;
+            unsigned count = 0;
+            bool     found = false;
+            uint32_t latency;
+            for (; next < pushed.size() && pushed[next].time_us < until; next++) {
+                if (pushed[next].time_us < changes[c].time_us) {
+                    continue;
+                }
+                if (!found && pushed[next].pressed == changes[c].pressed) {
+                    found   = true;
+                    latency = pushed[next].time_us - changes[c].time_us;
+                }
+                count++;
+            }
+            bool settled = !pushed.empty() && next > 0 && pushed[next - 1].pressed == changes[c].pressed;
+            if (found && settled) {
+                result.chatter += count - 1;
+                (changes[c].pressed ? result.press_latency_us : result.release_latency_us).push_back(latency);
+                if (verbose) {
+                    printf("%-20s %-12s key %u,%u %-7s at %8.2f ms +%.2f ms\n", implementation.name, trace.name.c_str(), trace.keys[k].row, trace.keys[k].col, changes[c].pressed ? "press" : "release", changes[c].time_us / 1000.0, latency / 1000.0);
+                }
+            } else {
+                result.missed++;
+                result.chatter += count;
+            }
+        }
+    }
+}
+
+double average_ms(const std::vector<uint32_t>& values) {
+    if (values.empty()) return 0;
+    double sum = 0;
+    for (auto value : values) sum += value;
+    return sum / values.size() / 1000.0;
+}
+
+double max_ms(const std::vector<uint32_t>& values) { return values.empty() ? 0 : *std::max_element(values.begin(), values.end()) / 1000.0; }
+
+}  // namespace
+
+TEST(DebounceReplay, LatencyAndChatter) {
+    auto traces   = synthetic_traces();
+    auto recorded = recorded_traces();
+    traces.insert(traces.end(), recorded.begin(), recorded.end());
+
+    printf("DEBOUNCE %d ms, scan every %u us\n", DEBOUNCE, SCAN_PERIOD_US);
+    printf("%-20s %-12s %7s %9s %9s %8s %9s %9s %7s %6s\n", "algorithm", "trace", "presses", "avg ms", "max ms", "releases", "avg ms", "max ms", "chatter", "missed");
+    for (auto& implementation : implementations) {
+        for (auto& trace : traces) {
+            Result result;
+            replay(implementation, trace, result);
+            printf("%-20s %-12s %7zu %9.2f %9.2f %8zu %9.2f %9.2f %7u %6u\n", implementation.name, trace.name.c_str(), result.press_latency_us.size(), average_ms(result.press_latency_us), max_ms(result.press_latency_us), result.release_latency_us.size(), average_ms(result.release_latency_us), max_ms(result.release_latency_us), result.chatter, result.missed);
+
+            SCOPED_TRACE(std::string(implementation.name) + " " + trace.name);
+            EXPECT_EQ(result.missed, 0u);
+            // bounces always settle within the trace, only eager algorithms pass noise spikes
+            bool lets_noise_through = trace.name == "noise" && (implementation.eager_press || implementation.eager_release);
+            if (!lets_noise_through) {
+                EXPECT_EQ(result.chatter, 0u);
+            }
+            if (trace.check_latency) {
+                // an eager change is seen by the first scan that samples the new level, a
+                // deferred one then waits for DEBOUNCE ms, rounded up to the timer and the scan
+                uint32_t eager_us    = trace.max_bounce_us + SCAN_PERIOD_US;
+                uint32_t deferred_us = trace.max_bounce_us + DEBOUNCE * 1000 + 1000 + SCAN_PERIOD_US;
+                EXPECT_LE(max_ms(result.press_latency_us) * 1000, implementation.eager_press ? eager_us : deferred_us);
+                EXPECT_LE(max_ms(result.release_latency_us) * 1000, implementation.eager_release ? eager_us : deferred_us);
+            }
+        }
+    }
+}
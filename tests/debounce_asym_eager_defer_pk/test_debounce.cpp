@@ -0,0 +1,46 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "debounce_test.hpp"
+
+// DEBOUNCE is 5ms, every trace character is one millisecond
+
+TEST_F(DebounceTest, PressesArePushedImmediately) {
+    EXPECT_EQ(replay("__-_-_----"),
+                     "__--------");
+}
+
+TEST_F(DebounceTest, ReleasesArePushedAfterBeingStable) {
+    EXPECT_EQ(replay("__--------__________"),
+                     "__-------------_____");
+}
+
+TEST_F(DebounceTest, ReleaseBouncesRestartTheWait) {
+    EXPECT_EQ(replay("__-_-_------_-__________"),
+                     "__-----------------_____");
+}
+
+TEST_F(DebounceTest, ReleasesDuringThePressLockWaitForTheLock) {
+    EXPECT_EQ(replay("__---___________"),
+                     "__-----------___");
+}
+
+TEST_F(DebounceTest, KeysInTheSameRowAreIndependent) {
+    auto output = replay({{0, 0, "__------______"},
+                          {0, 1, "____----------"}});
+    EXPECT_EQ(output[0],         "__-----------_");
+    EXPECT_EQ(output[1],         "____----------");
+}
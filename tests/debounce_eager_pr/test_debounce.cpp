@@ -0,0 +1,43 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "debounce_test.hpp"
+
+// DEBOUNCE is 5ms, every trace character is one millisecond
+
+TEST_F(DebounceTest, ChangesArePushedImmediately) {
+    EXPECT_EQ(replay("__--------________"),
+                     "__--------________");
+}
+
+TEST_F(DebounceTest, BouncesAreIgnoredWhileTheRowIsLocked) {
+    EXPECT_EQ(replay("__-_-_------_-_______"),
+                     "__----------_________");
+}
+
+TEST_F(DebounceTest, ChangesInALockedRowWaitForTheLock) {
+    auto output = replay({{0, 0, "__--------"},
+                          {0, 1, "___-------"}});
+    EXPECT_EQ(output[0],         "__--------");
+    EXPECT_EQ(output[1],         "_______---");
+}
+
+TEST_F(DebounceTest, RowsAreIndependent) {
+    auto output = replay({{0, 0, "__--------"},
+                          {1, 0, "___-------"}});
+    EXPECT_EQ(output[0],         "__--------");
+    EXPECT_EQ(output[1],         "___-------");
+}
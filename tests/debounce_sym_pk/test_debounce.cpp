@@ -0,0 +1,41 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "debounce_test.hpp"
+
+// DEBOUNCE is 5ms, every trace character is one millisecond
+
+TEST_F(DebounceTest, ChangesArePushedAfterBeingStable) {
+    EXPECT_EQ(replay("__--------________"),
+                     "_______--------___");
+}
+
+TEST_F(DebounceTest, BouncesRestartTheKeyCounter) {
+    EXPECT_EQ(replay("__-_-_----------________"),
+                     "___________----------___");
+}
+
+TEST_F(DebounceTest, ShortGlitchesAreFiltered) {
+    EXPECT_EQ(replay("___---_______"),
+                     "_____________");
+}
+
+TEST_F(DebounceTest, KeysInTheSameRowAreIndependent) {
+    auto output = replay({{0, 0, "__------------"},
+                          {0, 1, "_____---------"}});
+    EXPECT_EQ(output[0],         "_______-------");
+    EXPECT_EQ(output[1],         "__________----");
+}
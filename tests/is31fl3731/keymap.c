@@ -0,0 +1,34 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../basic/keymap.c"
+#include "is31fl3731.h"
+
+// Like most boards, the red, green and blue of a LED sit in different
+// rows of the PWM page, so every LED touches three 16 register transfers
+#define LED(driver, n) { driver, C1_1 + (n), C2_1 + (n), C3_1 + (n) }, \
+                       { driver, C4_1 + (n), C5_1 + (n), C6_1 + (n) }
+
+#define LEDS(driver) \
+    LED(driver, 0), LED(driver, 1), LED(driver, 2), LED(driver, 3), \
+    LED(driver, 4), LED(driver, 5), LED(driver, 6), LED(driver, 7), \
+    LED(driver, 8), LED(driver, 9), LED(driver, 10), LED(driver, 11), \
+    LED(driver, 12), LED(driver, 13), LED(driver, 14), LED(driver, 15)
+
+const is31_led g_is31_leds[DRIVER_LED_TOTAL] = {
+    LEDS(0),
+    LEDS(1),
+};
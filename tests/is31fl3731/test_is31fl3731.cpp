@@ -0,0 +1,121 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <cstdio>
+
+extern "C" {
+#include "i2c_master.h"
+#include "is31fl3731.h"
+}
+
+#define ADDR_1 0x74
+#define ADDR_2 0x76
+// 9 transfers of a register byte and 16 PWM bytes per driver
+#define FULL_PAGE (9 * 17)
+
+static unsigned bytes_sent[0x80];
+
+extern "C" i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    bytes_sent[address >> 1] += length;
+    return I2C_STATUS_SUCCESS;
+}
+
+class IS31FL3731 : public TestFixture {
+  public:
+    IS31FL3731() {
+        IS31FL3731_init(ADDR_1);
+        IS31FL3731_init(ADDR_2);
+        IS31FL3731_set_color_all(0, 0, 0);
+        IS31FL3731_update_pwm_buffers(ADDR_1, ADDR_2);
+        reset();
+    }
+
+    void reset() { memset(bytes_sent, 0, sizeof(bytes_sent)); }
+
+    unsigned flush() {
+        reset();
+        IS31FL3731_update_pwm_buffers(ADDR_1, ADDR_2);
+        return bytes_sent[ADDR_1] + bytes_sent[ADDR_2];
+    }
+};
+
+TEST_F(IS31FL3731, InitSendsTheWholeBufferOnce) {
+    IS31FL3731_init(ADDR_1);
+    EXPECT_EQ(flush(), 2u * FULL_PAGE);
+    EXPECT_EQ(flush(), 0u);
+}
+
+TEST_F(IS31FL3731, UnchangedColorsAreNotSent) {
+    IS31FL3731_set_color_all(10, 20, 30);
+    EXPECT_GT(flush(), 0u);
+    IS31FL3731_set_color_all(10, 20, 30);
+    EXPECT_EQ(flush(), 0u);
+}
+
+TEST_F(IS31FL3731, OnlyTheChangedTransfersOfOneChipAreSent) {
+    IS31FL3731_set_color(40, 255, 0, 0);
+    EXPECT_EQ(flush(), 17u);
+    EXPECT_EQ(bytes_sent[ADDR_1], 0u);
+    EXPECT_EQ(bytes_sent[ADDR_2], 17u);
+    IS31FL3731_set_color(40, 0, 255, 255);
+    EXPECT_EQ(flush(), 3u * 17);
+}
+
+TEST_F(IS31FL3731, WritePwmBufferStillWritesEverything) {
+    uint8_t buffer[144] = {0};
+    IS31FL3731_write_pwm_buffer(ADDR_1, buffer);
+    EXPECT_EQ(bytes_sent[ADDR_1], (unsigned)FULL_PAGE);
+}
+
+TEST_F(IS31FL3731, TypicalEffectsBytesPerFrame) {
+    const int frames = 64;
+    unsigned solid = 0, reactive = 0, breathing = 0, rainbow = 0;
+
+    for (int f = 0; f < frames; f++) {
+        IS31FL3731_set_color_all(0, 128, 255);
+        solid += flush();
+    }
+    IS31FL3731_set_color_all(0, 0, 0);
+    flush();
+    for (int f = 0; f < frames; f++) {
+        // a single lit key walking across the board
+        IS31FL3731_set_color_all(0, 0, 0);
+        IS31FL3731_set_color(f % DRIVER_LED_TOTAL, 255 - f * 4, 255 - f * 4, 255 - f * 4);
+        reactive += flush();
+    }
+    for (int f = 0; f < frames; f++) {
+        IS31FL3731_set_color_all(f * 4, f * 4, f * 4);
+        breathing += flush();
+    }
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+            IS31FL3731_set_color(i, (i + f) * 8, (i + f) * 8 + 85, (i + f) * 8 + 170);
+        }
+        rainbow += flush();
+    }
+
+    printf("bytes/frame: solid %u, reactive %u, breathing %u, rainbow %u, before %u\n", solid / frames, reactive / frames, breathing / frames, rainbow / frames, 2 * FULL_PAGE);
+    // the 48 registers no LED uses are never sent again
+    EXPECT_LE(solid, 2u * 6 * 17);
+    EXPECT_LE(reactive, frames * 2u * 3 * 17);
+    EXPECT_LE(breathing, frames * 2u * 6 * 17);
+    EXPECT_EQ(rainbow, frames * 2u * 6 * 17);
+    RecordProperty("solid_bytes_per_frame", solid / frames);
+    RecordProperty("reactive_bytes_per_frame", reactive / frames);
+    RecordProperty("breathing_bytes_per_frame", breathing / frames);
+    RecordProperty("rainbow_bytes_per_frame", rainbow / frames);
+}
@@ -0,0 +1,68 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "i2c_master.h"
+#include "is31fl3733.h"
+}
+
+#define ADDR_1 0x50
+// unlocking the command register and selecting the PWM page
+#define PAGE_SELECT (2 * 2)
+
+static unsigned bytes_sent;
+
+extern "C" i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    if (address >> 1 == ADDR_1) {
+        bytes_sent += length;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+class IS31FL3733 : public TestFixture {
+  public:
+    IS31FL3733() {
+        IS31FL3733_init(ADDR_1);
+        IS31FL3733_set_color_all(0, 0, 0);
+        flush();
+    }
+
+    unsigned flush() {
+        bytes_sent = 0;
+        IS31FL3733_update_pwm_buffers(ADDR_1, 0);
+        return bytes_sent;
+    }
+};
+
+TEST_F(IS31FL3733, InitSendsTheWholeBufferOnce) {
+    IS31FL3733_init(ADDR_1);
+    EXPECT_EQ(flush(), PAGE_SELECT + 12u * 17);
+    EXPECT_EQ(flush(), 0u);
+}
+
+TEST_F(IS31FL3733, UnchangedColorsAreNotSent) {
+    IS31FL3733_set_color_all(10, 20, 30);
+    EXPECT_EQ(flush(), PAGE_SELECT + 6u * 17);
+    IS31FL3733_set_color_all(10, 20, 30);
+    EXPECT_EQ(flush(), 0u);
+}
+
+TEST_F(IS31FL3733, OnlyTheChangedTransfersAreSent) {
+    IS31FL3733_set_color(3, 255, 0, 255);
+    EXPECT_EQ(flush(), PAGE_SELECT + 2u * 17);
+}
@@ -0,0 +1,139 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include "action_tapping.h"
+
+using testing::_;
+using testing::AnyNumber;
+
+// The scenarios of tests/basic/test_tapping.cpp, checking how long each key
+// event waits before it shows up in a report. One scan loop takes 1ms.
+class LatencyTrace : public TestFixture {
+   protected:
+    LatencyTrace() { latency_trace_reset(); }
+};
+
+TEST_F(LatencyTrace, PlainKeyIsReportedInTheSameScan) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    press_key(0, 0);
+    run_one_scan_loop();
+    release_key(0, 0);
+    run_one_scan_loop();
+
+    const latency_trace_t *trace = latency_trace_get();
+    EXPECT_EQ(trace->ms.count, 2u);
+    EXPECT_LE(trace->ms.max, 1);
+}
+
+TEST_F(LatencyTrace, TapA_SHFT_T_KeyWaitsForTheRelease) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    press_key(7, 0);
+    idle_for(10);
+    release_key(7, 0);
+    run_one_scan_loop();
+
+    // the press is held back until the release resolves it as a tap, event
+    // times have their low bit set so they can be 1ms late
+    const latency_trace_t *trace = latency_trace_get();
+    EXPECT_EQ(trace->ms.count, 2u);
+    EXPECT_GE(trace->ms.max, 9);
+    EXPECT_LE(trace->ms.max, 10);
+    EXPECT_EQ(trace->last_ms, 0);
+}
+
+TEST_F(LatencyTrace, HoldA_SHFT_T_KeyWaitsForTheTappingTerm) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    press_key(7, 0);
+    idle_for(TAPPING_TERM);
+    run_one_scan_loop();
+
+    const latency_trace_t *trace = latency_trace_get();
+    EXPECT_EQ(trace->ms.count, 1u);
+    EXPECT_GE(trace->last_ms, TAPPING_TERM - 1);
+    EXPECT_LE(trace->last_ms, TAPPING_TERM + 1);
+}
+
+TEST_F(LatencyTrace, KeyPressedDuringTappingTermWaitsInTheBuffer) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    press_key(7, 0);
+    run_one_scan_loop();
+    press_key(0, 0);
+    idle_for(TAPPING_TERM);
+
+    // both presses come out when the tapping term resolves the hold
+    const latency_trace_t *trace = latency_trace_get();
+    EXPECT_EQ(trace->ms.count, 2u);
+    EXPECT_LE(trace->ms.max, TAPPING_TERM + 1);
+    EXPECT_GE(trace->ms.min, TAPPING_TERM - 2);
+}
+
+TEST_F(LatencyTrace, PermissiveHoldKeyIsSettledWhenAKeyIsTyped) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    press_key(9, 1);
+    run_one_scan_loop();
+    press_key(0, 0);
+    idle_for(5);
+    release_key(0, 0);
+    run_one_scan_loop();
+
+    // the hold and the typed key wait for the release of the typed key, not
+    // for the tapping term
+    const latency_trace_t *trace = latency_trace_get();
+    EXPECT_EQ(trace->ms.count, 3u);
+    EXPECT_LE(trace->ms.max, 7);
+}
+
+TEST_F(LatencyTrace, ANewTapWithinTappingTermIsReportedAtOnce) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    press_key(7, 0);
+    run_one_scan_loop();
+    release_key(7, 0);
+    run_one_scan_loop();
+
+    // the second tap is sent on press, see test_tapping.cpp
+    latency_trace_reset();
+    press_key(7, 0);
+    run_one_scan_loop();
+    EXPECT_EQ(latency_trace_get()->ms.count, 1u);
+    EXPECT_LE(latency_trace_get()->last_ms, 1);
+    release_key(7, 0);
+    idle_for(TAPPING_TERM + 1);
+
+    // outside the tapping term the key is deferred again
+    latency_trace_reset();
+    press_key(7, 0);
+    idle_for(TAPPING_TERM / 2);
+    release_key(7, 0);
+    run_one_scan_loop();
+    EXPECT_LE(latency_trace_get()->ms.max, TAPPING_TERM / 2 + 1);
+}
+
+TEST_F(LatencyTrace, ReportsWithoutAKeyEventAreNotCounted) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    press_key(0, 0);
+    run_one_scan_loop();
+    send_keyboard_report();
+    send_keyboard_report();
+    EXPECT_EQ(latency_trace_get()->ms.count, 1u);
+}
@@ -0,0 +1,70 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "quantum.h"
+
+// Eight layers, each one only overriding a few keys so most lookups have
+// to fall through several transparent layers
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {KC_A,    KC_B,    KC_C,    KC_D,    KC_E,    KC_F,    KC_G,    KC_H,    KC_I,    MO(1)},
+        {KC_J,    KC_K,    KC_L,    KC_M,    KC_N,    KC_O,    KC_P,    KC_Q,    KC_R,    MO(2)},
+        {KC_S,    KC_T,    KC_U,    KC_V,    KC_W,    KC_X,    KC_Y,    KC_Z,    KC_1,    KC_2},
+        {KC_3,    KC_4,    KC_5,    KC_6,    KC_7,    KC_8,    KC_9,    KC_0,    KC_NO,   KC_NO},
+    },
+    [1] = {
+        {KC_F1,   _______, _______, _______, _______, _______, _______, _______, _______, _______},
+        {_______, KC_F2,   _______, _______, _______, _______, _______, _______, _______, _______},
+        {_______, _______, KC_F3,   _______, _______, _______, _______, _______, _______, _______},
+        {_______, _______, _______, KC_F4,   _______, _______, _______, _______, _______, _______},
+    },
+    [2] = {
+        {_______, KC_F5,   _______, _______, _______, _______, _______, _______, _______, _______},
+        {_______, _______, KC_F6,   _______, _______, _______, _______, _______, _______, _______},
+        {_______, _______, _______, KC_F7,   _______, _______, _______, _______, _______, _______},
+        {_______, _______, _______, _______, KC_F8,   _______, _______, _______, _______, _______},
+    },
+    [3] = {
+        {_______, _______, KC_F9,   _______, _______, _______, _______, _______, _______, _______},
+        {_______, _______, _______, KC_F10,  _______, _______, _______, _______, _______, _______},
+        {_______, _______, _______, _______, KC_F11,  _______, _______, _______, _______, _______},
+        {_______, _______, _______, _______, _______, KC_F12,  _______, _______, _______, _______},
+    },
+    [4] = {
+        {_______, _______, _______, KC_LEFT, _______, _______, _______, _______, _______, _______},
+        {_______, _______, _______, _______, KC_DOWN, _______, _______, _______, _______, _______},
+        {_______, _______, _______, _______, _______, KC_UP,   _______, _______, _______, _______},
+        {_______, _______, _______, _______, _______, _______, KC_RGHT, _______, _______, _______},
+    },
+    [5] = {
+        {_______, _______, _______, _______, KC_HOME, _______, _______, _______, _______, _______},
+        {_______, _______, _______, _______, _______, KC_END,  _______, _______, _______, _______},
+        {_______, _______, _______, _______, _______, _______, KC_PGUP, _______, _______, _______},
+        {_______, _______, _______, _______, _______, _______, _______, KC_PGDN, _______, _______},
+    },
+    [6] = {
+        {_______, _______, _______, _______, _______, KC_INS,  _______, _______, _______, _______},
+        {_______, _______, _______, _______, _______, _______, KC_DEL,  _______, _______, _______},
+        {_______, _______, _______, _______, _______, _______, _______, KC_BSPC, _______, _______},
+        {_______, _______, _______, _______, _______, _______, _______, _______, KC_ENT,  _______},
+    },
+    [7] = {
+        {_______, _______, _______, _______, _______, _______, KC_MUTE, _______, _______, _______},
+        {_______, _______, _______, _______, _______, _______, _______, KC_VOLD, _______, _______},
+        {_______, _______, _______, _______, _______, _______, _______, _______, KC_VOLU, _______},
+        {_______, _______, _______, _______, _______, _______, _______, _______, _______, KC_MPLY},
+    },
+};
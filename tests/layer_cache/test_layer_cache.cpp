@@ -0,0 +1,118 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <chrono>
+#include <cstdio>
+
+using testing::_;
+using testing::AnyNumber;
+
+class LayerCache : public TestFixture {};
+
+// The layer walk layer_switch_get_layer does without LAYER_LOOKUP_CACHE
+static uint8_t uncached_get_layer(keypos_t key) {
+    uint32_t layers = layer_state | default_layer_state;
+    for (int8_t i = 31; i >= 0; i--) {
+        if (layers & (1UL << i)) {
+            if (action_for_key(i, key).code != ACTION_TRANSPARENT) {
+                return i;
+            }
+        }
+    }
+    return 0;
+}
+
+static const uint32_t all_layers = 0xFF;
+
+TEST_F(LayerCache, MatchesUncachedLookupForEveryLayerState) {
+    for (uint32_t state = 0; state <= all_layers; state++) {
+        layer_state = state;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = { .col = col, .row = row };
+                ASSERT_EQ(layer_switch_get_layer(key), uncached_get_layer(key))
+                    << "layer_state " << state << " row " << int(row) << " col " << int(col);
+            }
+        }
+    }
+}
+
+TEST_F(LayerCache, FollowsLayerChanges) {
+    TestDriver driver;
+    // Layer changes clear the keyboard report
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    keypos_t key = { .col = 0, .row = 0 };
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+    layer_on(7);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+    default_layer_set(1UL << 3);
+    key.col = 2;
+    EXPECT_EQ(layer_switch_get_layer(key), 3);
+    default_layer_set(0);
+}
+
+TEST_F(LayerCache, MomentaryLayerKeyReportsCachedLayerKey) {
+    TestDriver driver;
+    press_key(9, 0);
+    // Switching layers clears the report
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    press_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F1)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    release_key(9, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F1))).Times(AnyNumber());
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    // The release still goes to the layer the key was pressed on
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(LayerCache, LookupsPerSecondBenchmark) {
+    const unsigned rounds = 20000;
+    layer_state = all_layers;
+    volatile uint8_t sink = 0;
+
+    auto measure = [&](uint8_t (*lookup)(keypos_t)) {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < rounds; i++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    sink = lookup((keypos_t){ .col = col, .row = row });
+                }
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return rounds * MATRIX_ROWS * MATRIX_COLS / elapsed.count();
+    };
+
+    double uncached = measure(uncached_get_layer);
+    double cached = measure(layer_switch_get_layer);
+    (void)sink;
+    printf("8 layer lookups/s: uncached %.0f, cached %.0f (%.1fx)\n", uncached, cached, cached / uncached);
+    RecordProperty("uncached_lookups_per_second", int(uncached));
+    RecordProperty("cached_lookups_per_second", int(cached));
+    layer_state = 0;
+}
@@ -0,0 +1,26 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../basic/config.h"
+
+// Pins of the simulated matrix, see matrix_sim.h
+#define MATRIX_ROW_PINS { 0, 1, 2, 3 }
+#define MATRIX_COL_PINS { 8, 9, 10, 11, 12, 13, 14, 15, 16, 17 }
+
+// Raw changes are pushed by the next scan
+#define DEBOUNCE 0
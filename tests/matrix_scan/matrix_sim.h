@@ -0,0 +1,43 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* A simulated switch matrix with a diode on every switch. Row pins are 0 to
+ * MATRIX_ROWS - 1, col pins start at 8. A pin driven low pulls down the pins
+ * it is connected to through a pressed switch, in the direction of the diode.
+ */
+
+#define MATRIX_SIM_COL_PIN(col) (8 + (col))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void matrix_sim_reset(bool col2row);
+void matrix_sim_press(uint8_t row, uint8_t col, bool pressed);
+uint32_t matrix_sim_pin_reads(void);
+
+void matrix_sim_set_input(uint8_t pin);
+void matrix_sim_set_output_low(uint8_t pin);
+bool matrix_sim_read(uint8_t pin);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,52 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Builds quantum/matrix.c against the simulated pins, with every public
+ * function renamed to MATRIX_SIM_PREFIX##_<function> so several builds can
+ * be linked into the test. Define MATRIX_SIM_PREFIX and DIODE_DIRECTION, and
+ * optionally MATRIX_SKIP_IDLE_SCAN, before including this file.
+ */
+
+#include "matrix_sim.h"
+
+#define pin_t uint8_t
+#define setPinInput(pin) matrix_sim_set_input(pin)
+#define setPinInputHigh(pin) matrix_sim_set_input(pin)
+#define setPinOutput(pin)
+#define writePinLow(pin) matrix_sim_set_output_low(pin)
+#define readPin(pin) matrix_sim_read(pin)
+
+#define MATRIX_SIM_NAME(name) MATRIX_SIM_PASTE(MATRIX_SIM_PREFIX, name)
+#define MATRIX_SIM_PASTE(prefix, name) MATRIX_SIM_PASTE_(prefix, name)
+#define MATRIX_SIM_PASTE_(prefix, name) prefix##_##name
+
+#define matrix_init MATRIX_SIM_NAME(matrix_init)
+#define matrix_scan MATRIX_SIM_NAME(matrix_scan)
+#define matrix_init_quantum MATRIX_SIM_NAME(matrix_init_quantum)
+#define matrix_scan_quantum MATRIX_SIM_NAME(matrix_scan_quantum)
+#define matrix_init_kb MATRIX_SIM_NAME(matrix_init_kb)
+#define matrix_scan_kb MATRIX_SIM_NAME(matrix_scan_kb)
+#define matrix_init_user MATRIX_SIM_NAME(matrix_init_user)
+#define matrix_scan_user MATRIX_SIM_NAME(matrix_scan_user)
+#define matrix_rows MATRIX_SIM_NAME(matrix_rows)
+#define matrix_cols MATRIX_SIM_NAME(matrix_cols)
+#define matrix_is_modified MATRIX_SIM_NAME(matrix_is_modified)
+#define matrix_is_on MATRIX_SIM_NAME(matrix_is_on)
+#define matrix_get_row MATRIX_SIM_NAME(matrix_get_row)
+#define matrix_print MATRIX_SIM_NAME(matrix_print)
+#define matrix_key_count MATRIX_SIM_NAME(matrix_key_count)
+
+#include "../../quantum/matrix.c"
@@ -0,0 +1,144 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <cstring>
+
+extern "C" {
+#include "quantum.h"
+#include "matrix_sim.h"
+
+void         col2row_matrix_init(void);
+uint8_t      col2row_matrix_scan(void);
+matrix_row_t col2row_matrix_get_row(uint8_t row);
+void         row2col_matrix_init(void);
+uint8_t      row2col_matrix_scan(void);
+matrix_row_t row2col_matrix_get_row(uint8_t row);
+void         col2row_full_matrix_init(void);
+uint8_t      col2row_full_matrix_scan(void);
+matrix_row_t col2row_full_matrix_get_row(uint8_t row);
+}
+
+static bool     col2row;
+static bool     pressed[MATRIX_ROWS][MATRIX_COLS];
+static bool     output_low[MATRIX_SIM_COL_PIN(MATRIX_COLS)];
+static uint32_t pin_reads;
+
+void matrix_sim_reset(bool diode_col2row) {
+    col2row = diode_col2row;
+    memset(pressed, 0, sizeof(pressed));
+    memset(output_low, 0, sizeof(output_low));
+    pin_reads = 0;
+}
+
+void matrix_sim_press(uint8_t row, uint8_t col, bool state) { pressed[row][col] = state; }
+
+uint32_t matrix_sim_pin_reads(void) { return pin_reads; }
+
+void matrix_sim_set_input(uint8_t pin) { output_low[pin] = false; }
+
+void matrix_sim_set_output_low(uint8_t pin) { output_low[pin] = true; }
+
+bool matrix_sim_read(uint8_t pin) {
+    pin_reads++;
+    if (output_low[pin]) {
+        return false;
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (!pressed[row][col]) continue;
+            // current only flows through the diode from the pin read towards the pin driven low
+            uint8_t from = col2row ? MATRIX_SIM_COL_PIN(col) : row;
+            uint8_t to   = col2row ? row : MATRIX_SIM_COL_PIN(col);
+            if (pin == from && output_low[to]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+struct MatrixBuild {
+    const char* name;
+    bool        col2row;
+    bool        skip_idle;
+    void (*init)(void);
+    uint8_t (*scan)(void);
+    matrix_row_t (*get_row)(uint8_t row);
+};
+
+static const MatrixBuild col2row_skip = {"col2row", true, true, col2row_matrix_init, col2row_matrix_scan, col2row_matrix_get_row};
+static const MatrixBuild row2col_skip = {"row2col", false, true, row2col_matrix_init, row2col_matrix_scan, row2col_matrix_get_row};
+static const MatrixBuild col2row_full = {"col2row_full", true, false, col2row_full_matrix_init, col2row_full_matrix_scan, col2row_full_matrix_get_row};
+
+class MatrixScan : public ::testing::TestWithParam<MatrixBuild> {
+   protected:
+    void SetUp() override {
+        matrix_sim_reset(GetParam().col2row);
+        GetParam().init();
+    }
+
+    // Scans once and returns the number of pins read
+    uint32_t scan() {
+        uint32_t before = matrix_sim_pin_reads();
+        GetParam().scan();
+        return matrix_sim_pin_reads() - before;
+    }
+};
+
+TEST_P(MatrixScan, FindsPressesAndReleases) {
+    matrix_sim_press(1, 2, true);
+    scan();
+    EXPECT_EQ(GetParam().get_row(1), 1 << 2);
+
+    matrix_sim_press(3, 9, true);
+    scan();
+    EXPECT_EQ(GetParam().get_row(1), 1 << 2);
+    EXPECT_EQ(GetParam().get_row(3), 1 << 9);
+
+    matrix_sim_press(1, 2, false);
+    matrix_sim_press(3, 9, false);
+    scan();
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(GetParam().get_row(row), 0);
+    }
+}
+
+TEST_P(MatrixScan, PinReadsPerScan) {
+    const uint32_t full = MATRIX_ROWS * MATRIX_COLS;
+    bool           skip = GetParam().skip_idle;
+    uint32_t       idle = GetParam().col2row ? MATRIX_COLS : MATRIX_ROWS;
+
+    uint32_t idle_reads = scan();
+    EXPECT_EQ(idle_reads, skip ? idle : full);
+
+    // the activity check stops at the first active pin
+    matrix_sim_press(0, 0, true);
+    uint32_t press_reads = scan();
+    EXPECT_EQ(press_reads, skip ? 1 + full : full);
+
+    // a held key always takes a full scan, so its release is seen
+    uint32_t held_reads = scan();
+    EXPECT_EQ(held_reads, full);
+    matrix_sim_press(0, 0, false);
+    EXPECT_EQ(scan(), full);
+    EXPECT_EQ(GetParam().get_row(0), 0);
+
+    EXPECT_EQ(scan(), idle_reads);
+    printf("%-12s pin reads per scan: idle %u, press %u, held %u\n", GetParam().name, idle_reads, press_reads, held_reads);
+}
+
+INSTANTIATE_TEST_CASE_P(Builds, MatrixScan, ::testing::Values(col2row_skip, row2col_skip, col2row_full), [](const ::testing::TestParamInfo<MatrixBuild>& info) { return std::string(info.param.name); });
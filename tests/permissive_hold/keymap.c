@@ -0,0 +1,26 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../basic/keymap.c"
+#include "action_tapping.h"
+
+bool get_permissive_hold(uint16_t keycode) {
+    return keycode == CTL_T(KC_Q);
+}
+
+uint16_t get_tapping_term(uint16_t keycode) {
+    return keycode == SFT_T(KC_P) ? 500 : TAPPING_TERM;
+}
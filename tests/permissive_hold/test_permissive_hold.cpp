@@ -0,0 +1,95 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include "action_tapping.h"
+
+using testing::_;
+using testing::InSequence;
+
+class PermissiveHold : public TestFixture {};
+
+TEST_F(PermissiveHold, TypingAKeyDuringPermissiveHoldKeySettlesTheHoldAtOnce) {
+    TestDriver driver;
+    InSequence s;
+
+    press_key(9, 1);
+    run_one_scan_loop();
+    press_key(0, 0);
+    // Nothing is decided while the other key is only pressed
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    release_key(0, 0);
+    // The release decides the hold, and the buffered keys follow in the same scan
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL, KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL)));
+    run_one_scan_loop();
+    release_key(9, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(PermissiveHold, TapA_PermissiveHoldKeyReportsKey) {
+    TestDriver driver;
+    InSequence s;
+
+    press_key(9, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    release_key(9, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Q)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(PermissiveHold, PressingAKeyDuringPermissiveHoldKeyWaitsForTheRelease) {
+    TestDriver driver;
+    InSequence s;
+
+    press_key(9, 1);
+    run_one_scan_loop();
+    press_key(0, 0);
+    idle_for(TAPPING_TERM / 2);
+    release_key(9, 1);
+    // The interrupted mod tap is a hold, but only once it is released
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL, KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    run_one_scan_loop();
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(PermissiveHold, TypingAKeyDuringALongTappingTermKeySettlesTheHoldAtOnce) {
+    TestDriver driver;
+    InSequence s;
+
+    // SFT_T(KC_P) is not a permissive hold key, but its tapping term is 500ms
+    press_key(7, 0);
+    run_one_scan_loop();
+    press_key(0, 0);
+    run_one_scan_loop();
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT, KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    run_one_scan_loop();
+    release_key(7, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
@@ -0,0 +1,167 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+extern "C" {
+#include "util.h"
+}
+
+class Report : public TestFixture {};
+
+// Size of the NKRO bitmap on LUFA and ChibiOS
+static const uint8_t nkro_bytes = 30;
+
+// The byte loops has_anykey and get_first_key used before
+static uint8_t byte_loop_pop(const uint8_t *p, uint8_t len) {
+    uint8_t cnt = 0;
+    while (len--) {
+        if (*p++) cnt++;
+    }
+    return cnt;
+}
+
+static uint8_t byte_loop_first(const uint8_t *p, uint8_t len) {
+    uint8_t i = 0;
+    for (; i < len && !p[i]; i++)
+        ;
+    return i;
+}
+
+static uint8_t shift_loop_biton(uint32_t bits) {
+    uint8_t n = 0;
+    while (bits >>= 1) n++;
+    return n;
+}
+
+static uint8_t clear_loop_bitpop(uint32_t bits) {
+    uint8_t c;
+    for (c = 0; bits; c++)
+        bits &= bits - 1;
+    return c;
+}
+
+// Random buffer where most bytes are zero, like a key report
+static void fill_sparse(std::mt19937 &rng, uint8_t *p, uint8_t len) {
+    for (uint8_t i = 0; i < len; i++) {
+        p[i] = rng() % 4 == 0 ? (1 << (rng() % 8)) | (rng() % 2 ? rng() & 0xFF : 0) : 0;
+    }
+}
+
+TEST_F(Report, HasAnykeyCountsUsedSlots) {
+    EXPECT_EQ(has_anykey(keyboard_report), 0);
+    add_key(KC_A);
+    add_key(KC_Z);
+    EXPECT_EQ(has_anykey(keyboard_report), 2);
+    del_key(KC_A);
+    EXPECT_EQ(has_anykey(keyboard_report), 1);
+    clear_keys();
+    EXPECT_EQ(has_anykey(keyboard_report), 0);
+}
+
+TEST_F(Report, GetFirstKeyReturnsTheFirstSlot) {
+    EXPECT_EQ(get_first_key(keyboard_report), 0);
+    add_key(KC_B);
+    add_key(KC_A);
+    EXPECT_EQ(get_first_key(keyboard_report), KC_B);
+    clear_keys();
+}
+
+TEST_F(Report, BytepopMatchesTheByteLoop) {
+    std::mt19937 rng(1);
+    uint8_t buffer[64 + 3];
+    for (int round = 0; round < 2000; round++) {
+        uint8_t offset = round % 4;
+        uint8_t len = rng() % 64;
+        fill_sparse(rng, buffer + offset, len);
+        ASSERT_EQ(bytepop(buffer + offset, len), byte_loop_pop(buffer + offset, len)) << "len " << int(len);
+    }
+    memset(buffer, 0xFF, sizeof(buffer));
+    EXPECT_EQ(bytepop(buffer, 64), 64);
+    memset(buffer, 0x80, sizeof(buffer));
+    EXPECT_EQ(bytepop(buffer + 1, 63), 63);
+}
+
+TEST_F(Report, BytefirstMatchesTheByteLoop) {
+    std::mt19937 rng(2);
+    uint8_t buffer[64 + 3];
+    for (int round = 0; round < 2000; round++) {
+        uint8_t offset = round % 4;
+        uint8_t len = rng() % 64;
+        memset(buffer, 0, sizeof(buffer));
+        if (len && round % 8) {
+            buffer[offset + rng() % len] = 1 << (rng() % 8);
+        }
+        ASSERT_EQ(bytefirst(buffer + offset, len), byte_loop_first(buffer + offset, len)) << "len " << int(len);
+    }
+}
+
+TEST_F(Report, BitHelpersMatchTheLoops) {
+    for (uint32_t bits = 0; bits < 0x10000; bits++) {
+        ASSERT_EQ(biton16(bits), shift_loop_biton(bits));
+        ASSERT_EQ(bitpop16(bits), clear_loop_bitpop(bits));
+        if (bits < 0x100) {
+            ASSERT_EQ(biton(bits), shift_loop_biton(bits));
+            ASSERT_EQ(bitpop(bits), clear_loop_bitpop(bits));
+        }
+    }
+    std::mt19937 rng(3);
+    for (int round = 0; round < 10000; round++) {
+        uint32_t bits = rng() >> (rng() % 32);
+        ASSERT_EQ(biton32(bits), shift_loop_biton(bits));
+        ASSERT_EQ(bitpop32(bits), clear_loop_bitpop(bits));
+    }
+}
+
+TEST_F(Report, KeysPerMicrosecondBenchmark) {
+    const unsigned rounds = 200000;
+    std::mt19937 rng(4);
+    uint8_t six_kro[KEYBOARD_REPORT_KEYS] = {0};
+    uint8_t nkro[nkro_bytes];
+    fill_sparse(rng, nkro, nkro_bytes);
+    six_kro[2] = KC_A;
+    volatile uint8_t sink = 0;
+
+    auto measure = [&](uint8_t (*scan)(const uint8_t *, uint8_t), const uint8_t *report, uint8_t len, unsigned keys) {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < rounds; i++) {
+            sink = scan(report, len);
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return rounds * keys / elapsed.count();
+    };
+
+    double six_loop = measure(byte_loop_pop, six_kro, sizeof(six_kro), KEYBOARD_REPORT_KEYS);
+    double six_word = measure(bytepop, six_kro, sizeof(six_kro), KEYBOARD_REPORT_KEYS);
+    double nkro_loop = measure(byte_loop_pop, nkro, nkro_bytes, nkro_bytes * 8);
+    double nkro_word = measure(bytepop, nkro, nkro_bytes, nkro_bytes * 8);
+    memset(nkro, 0, nkro_bytes);
+    nkro[nkro_bytes - 1] = 1;
+    double first_loop = measure(byte_loop_first, nkro, nkro_bytes, nkro_bytes * 8);
+    double first_word = measure(bytefirst, nkro, nkro_bytes, nkro_bytes * 8);
+    (void)sink;
+    printf("has_anykey keys/us: 6KRO %.0f -> %.0f, NKRO %.0f -> %.0f\n", six_loop, six_word, nkro_loop, nkro_word);
+    printf("get_first_key keys/us: NKRO %.0f -> %.0f\n", first_loop, first_word);
+    RecordProperty("six_kro_byte_loop_keys_per_us", int(six_loop));
+    RecordProperty("six_kro_word_keys_per_us", int(six_word));
+    RecordProperty("nkro_byte_loop_keys_per_us", int(nkro_loop));
+    RecordProperty("nkro_word_keys_per_us", int(nkro_word));
+    RecordProperty("nkro_first_byte_loop_keys_per_us", int(first_loop));
+    RecordProperty("nkro_first_word_keys_per_us", int(first_word));
+}
@@ -0,0 +1,49 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "../basic/keymap.c"
+#include "rgb_matrix.h"
+
+unsigned rgb_flushes;
+
+static void init(void) {}
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void flush(void) { rgb_flushes++; }
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = init,
+    .flush         = flush,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+};
+
+#define ROW(r) { (r) * 10 + 0, (r) * 10 + 1, (r) * 10 + 2, (r) * 10 + 3, (r) * 10 + 4, \
+                 (r) * 10 + 5, (r) * 10 + 6, (r) * 10 + 7, (r) * 10 + 8, (r) * 10 + 9 }
+#define POINT(r, c) { (c) * 24, (r) * 21 }
+#define POINTS(r) POINT(r, 0), POINT(r, 1), POINT(r, 2), POINT(r, 3), POINT(r, 4), \
+                  POINT(r, 5), POINT(r, 6), POINT(r, 7), POINT(r, 8), POINT(r, 9)
+#define FLAGS 4, 4, 4, 4, 4, 4, 4, 4, 4, 4
+
+led_config_t g_led_config = {
+    { ROW(0), ROW(1), ROW(2), ROW(3) },
+    { POINTS(0), POINTS(1), POINTS(2), POINTS(3) },
+    { FLAGS, FLAGS, FLAGS, FLAGS },
+};
@@ -0,0 +1,85 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+extern unsigned rgb_flushes;
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class RgbMatrix : public TestFixture {
+  public:
+    // Runs the scan loop until the next frame has been flushed
+    void run_one_frame() {
+        unsigned flushes = rgb_flushes;
+        for (unsigned i = 0; i < 1000 && rgb_flushes == flushes; i++) {
+            run_one_scan_loop();
+        }
+        ASSERT_NE(rgb_flushes, flushes);
+    }
+};
+
+TEST_F(RgbMatrix, ExpensiveEffectIsSpreadOverTheBudget) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CUSTOM_COSTLY);
+    run_one_frame();
+    run_one_frame();
+    // 4000 us budget at 1000 us per LED
+    EXPECT_EQ(rgb_matrix_get_render_chunk(), 4);
+
+    // no rgb_matrix_task() call keeps the keyboard from scanning for longer than the budget
+    for (unsigned i = 0; i < 100; i++) {
+        uint32_t start = timer_read32();
+        run_one_scan_loop();
+        // the scan loop itself takes 1 ms
+        EXPECT_LE(timer_elapsed32(start), RGB_MATRIX_RENDER_BUDGET / 1000 + 1);
+    }
+}
+
+TEST_F(RgbMatrix, CheapEffectRendersTheWholeFrameAtOnce) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CUSTOM_COSTLY);
+    run_one_frame();
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    for (unsigned i = 0; i < 20; i++) {
+        run_one_frame();
+    }
+    EXPECT_EQ(rgb_matrix_get_render_chunk(), DRIVER_LED_TOTAL);
+}
+
+TEST_F(RgbMatrix, FrameTimeIsReported) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CUSTOM_COSTLY);
+    run_one_frame();
+    run_one_frame();
+    uint32_t frame_us = rgb_matrix_get_frame_us();
+    // 40 ms of rendering plus a scan loop between each of the ten chunks
+    EXPECT_GE(frame_us, 40000u);
+    EXPECT_LE(frame_us, 52000u);
+
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    for (unsigned i = 0; i < 20; i++) {
+        run_one_frame();
+    }
+    EXPECT_LT(rgb_matrix_get_frame_us(), frame_us);
+}
@@ -0,0 +1,69 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../basic/keymap.c"
+#include "rgb_matrix.h"
+#include <string.h>
+
+// What the LEDs show after the last flush, and how many flushes there were
+RGB      rgb_frame[DRIVER_LED_TOTAL];
+unsigned rgb_flushes;
+static RGB rgb_buffer[DRIVER_LED_TOTAL];
+
+static void init(void) {}
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    rgb_buffer[index] = (RGB){ r, g, b };
+}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+        set_color(i, r, g, b);
+    }
+}
+
+static void flush(void) {
+    memcpy(rgb_frame, rgb_buffer, sizeof(rgb_frame));
+    rgb_flushes++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = init,
+    .flush         = flush,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+};
+
+// 5 rows of 20 LEDs with a key on every other LED of the first 4 rows. The
+// first and last LEDs of the keys are modifiers, the last row is underglow.
+#define ROW(r) { (r) * 20 + 0, (r) * 20 + 2, (r) * 20 + 4, (r) * 20 + 6, (r) * 20 + 8, \
+                 (r) * 20 + 10, (r) * 20 + 12, (r) * 20 + 14, (r) * 20 + 16, (r) * 20 + 18 }
+#define POINT(i) { ((i) % 20) * 224 / 19, ((i) / 20) * 16 }
+#define POINTS(i) POINT(i), POINT(i + 1), POINT(i + 2), POINT(i + 3), POINT(i + 4), \
+                  POINT(i + 5), POINT(i + 6), POINT(i + 7), POINT(i + 8), POINT(i + 9)
+#define FLAGS(f) f, f, f, f, f, f, f, f, f, f
+
+led_config_t g_led_config = {
+    { ROW(0), ROW(1), ROW(2), ROW(3) },
+    {
+        POINTS(0), POINTS(10), POINTS(20), POINTS(30), POINTS(40),
+        POINTS(50), POINTS(60), POINTS(70), POINTS(80), POINTS(90),
+    },
+    {
+        FLAGS(1), FLAGS(4), FLAGS(4), FLAGS(4), FLAGS(4),
+        FLAGS(4), FLAGS(4), FLAGS(1), FLAGS(2), FLAGS(2),
+    },
+};
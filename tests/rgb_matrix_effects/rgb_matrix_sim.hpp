@@ -0,0 +1,110 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+extern "C" {
+#include "quantum.h"
+#include "rgb_matrix.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+// filled in by the driver in keymap.c
+extern RGB      rgb_frame[DRIVER_LED_TOTAL];
+extern unsigned rgb_flushes;
+}
+
+// Runs rgb_matrix effects off the keyboard. Every effect starts from the same
+// state at time 0 and each step() renders exactly one frame, so the frames of
+// an effect are the same on every run.
+class RgbMatrixSim {
+   public:
+    static const char* effect_name(uint8_t mode) {
+        static const char* const names[] = {
+            "NONE",
+#define RGB_MATRIX_EFFECT(name, ...) #name,
+#include "rgb_matrix_animations/rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+        };
+        return mode < sizeof(names) / sizeof(names[0]) ? names[mode] : "?";
+    }
+
+    void start(uint8_t mode, unsigned seed = 1) {
+        // one frame of nothing, so the effect sees its init frame again
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_NONE);
+        step();
+
+        set_time(0);
+        srand(seed);
+        rgb_matrix_init();
+        // restarts the timers of rgb_matrix at 0
+        rgb_matrix_task();
+#ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+        memset(rgb_frame_buffer, 0, sizeof(rgb_frame_buffer));
+#endif
+        rgb_matrix_config.enable = 1;
+        rgb_matrix_config.speed  = UINT8_MAX / 2;
+        rgb_matrix_set_flags(LED_FLAG_ALL);
+        rgb_matrix_sethsv_noeeprom(40, 255, 255);
+        rgb_matrix_mode_noeeprom(mode);
+    }
+
+    // A key hit, as seen by the reactive effects
+    void hit(uint8_t col, uint8_t row) {
+        keyrecord_t record;
+        record.event.key     = (keypos_t){.col = col, .row = row};
+        record.event.pressed = true;
+        record.event.time    = timer_read();
+        process_rgb_matrix(KC_A, &record);
+    }
+
+    // Renders the next frame, RGB_MATRIX_LED_FLUSH_LIMIT ms after the last one
+    const RGB* step() {
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+        unsigned flushes = rgb_flushes;
+        for (unsigned i = 0; i < 4 * DRIVER_LED_TOTAL && rgb_flushes == flushes; i++) {
+            rgb_matrix_task();
+        }
+        return rgb_frame;
+    }
+
+    // Draws the current frame as a binary PPM, each LED a square at its point
+    bool write_ppm(const std::string& path) const {
+        const unsigned width = 224 + 8, height = 64 + 8, size = 7;
+        std::string    pixels(width * height * 3, '\0');
+        for (unsigned i = 0; i < DRIVER_LED_TOTAL; i++) {
+            for (unsigned y = 0; y < size; y++) {
+                for (unsigned x = 0; x < size; x++) {
+                    size_t offset = ((g_led_config.point[i].y + y) * width + g_led_config.point[i].x + x) * 3;
+                    pixels[offset]     = rgb_frame[i].r;
+                    pixels[offset + 1] = rgb_frame[i].g;
+                    pixels[offset + 2] = rgb_frame[i].b;
+                }
+            }
+        }
+        FILE* file = fopen(path.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+        fprintf(file, "P6\n%u %u\n255\n", width, height);
+        bool written = fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+        return fclose(file) == 0 && written;
+    }
+};
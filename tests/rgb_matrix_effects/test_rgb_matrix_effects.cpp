@@ -0,0 +1,103 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include "rgb_matrix_sim.hpp"
+#include <chrono>
+
+extern "C" {
+#include "led_tables.h"
+}
+
+class RgbMatrixEffects : public TestFixture {};
+
+// hsv_to_rgb() as it was written with a division, without the CIE1931 curve
+static RGB reference_hsv_to_rgb(HSV hsv) {
+    if (hsv.s == 0) {
+        return (RGB){ hsv.v, hsv.v, hsv.v };
+    }
+    uint16_t h = hsv.h, s = hsv.s, v = hsv.v;
+    uint8_t region = h * 6 / 255;
+    uint8_t remainder = (h * 2 - region * 85) * 3;
+    uint8_t p = (v * (255 - s)) >> 8;
+    uint8_t q = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    uint8_t t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+    switch (region) {
+        case 6:
+        case 0: return (RGB){ (uint8_t)v, t, p };
+        case 1: return (RGB){ q, (uint8_t)v, p };
+        case 2: return (RGB){ p, (uint8_t)v, t };
+        case 3: return (RGB){ p, q, (uint8_t)v };
+        case 4: return (RGB){ t, p, (uint8_t)v };
+        default: return (RGB){ (uint8_t)v, p, q };
+    }
+}
+
+static uint8_t cie(uint8_t value) {
+#ifdef USE_CIE1931_CURVE
+    return CIE1931_CURVE[value];
+#else
+    return value;
+#endif
+}
+
+TEST_F(RgbMatrixEffects, HueConversionMatchesTheDivision) {
+    for (unsigned s = 0; s < 256; s++) {
+        for (unsigned v = 0; v < 256; v++) {
+            SV sv = sv_prepare(s, v);
+            for (unsigned h = 0; h < 256; h++) {
+                HSV hsv = { (uint8_t)h, (uint8_t)s, (uint8_t)v };
+                RGB expected = reference_hsv_to_rgb(hsv);
+                if (s != 0) {
+                    expected = (RGB){ cie(expected.r), cie(expected.g), cie(expected.b) };
+                }
+                RGB rgb = sv_hue_to_rgb(sv, h);
+                ASSERT_EQ(rgb.r, expected.r) << h << " " << s << " " << v;
+                ASSERT_EQ(rgb.g, expected.g) << h << " " << s << " " << v;
+                ASSERT_EQ(rgb.b, expected.b) << h << " " << s << " " << v;
+                RGB single = hsv_to_rgb(hsv);
+                ASSERT_EQ(memcmp(&single, &rgb, sizeof(RGB)), 0);
+            }
+        }
+    }
+}
+
+TEST_F(RgbMatrixEffects, MicrosecondsPerFrameBenchmark) {
+    RgbMatrixSim sim;
+    // short enough for the hits to stay in the last hit tracker
+    const unsigned frames = 200;
+
+    double total = 0;
+    for (uint8_t mode = 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        sim.start(mode);
+        // a few hits for the reactive effects
+        sim.hit(0, 0);
+        sim.hit(5, 2);
+        sim.hit(9, 3);
+
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < frames; i++) {
+            sim.step();
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        double us = elapsed.count() / frames;
+        total += us;
+        printf("%-26s %6.2f us/frame\n", RgbMatrixSim::effect_name(mode), us);
+        RecordProperty(std::string(RgbMatrixSim::effect_name(mode)) + "_us_per_frame", std::to_string(us));
+    }
+    printf("all effects: %.2f us/frame for %u LEDs\n", total, DRIVER_LED_TOTAL);
+    RecordProperty("all_effects_us_per_frame", std::to_string(total));
+}
@@ -0,0 +1,108 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include "rgb_matrix_sim.hpp"
+#include <map>
+#include <set>
+
+// FNV-1a checksums of the frames of run_effect() for every effect. After a
+// change that is meant to alter an effect, update its checksum from the
+// failure message, and check the frames with QMK_RGB_MATRIX_FRAMES first.
+static const std::map<std::string, uint32_t> golden = {
+    {"SOLID_COLOR", 0xe9621f41},
+    {"ALPHAS_MODS", 0xadfebc8d},
+    {"GRADIENT_UP_DOWN", 0x52331a5d},
+    {"BREATHING", 0x306ab61d},
+    {"CYCLE_ALL", 0xd2f7a0c5},
+    {"CYCLE_LEFT_RIGHT", 0x77789000},
+    {"CYCLE_UP_DOWN", 0xe054d105},
+    {"RAINBOW_MOVING_CHEVRON", 0xd83f016b},
+    {"DUAL_BEACON", 0x30808a5e},
+    {"RAINBOW_BEACON", 0xd92395fa},
+    {"PINWHEELS", 0x54936b06},
+    {"TYPING_HEATMAP", 0xff706435},
+    {"SOLID_REACTIVE_SIMPLE", 0x9dc42d42},
+    {"SOLID_REACTIVE", 0x63cb4fdf},
+    {"SOLID_REACTIVE_WIDE", 0x7c141bf9},
+    {"SOLID_REACTIVE_MULTIWIDE", 0x7f742925},
+    {"SOLID_REACTIVE_CROSS", 0xc4d3598e},
+    {"SOLID_REACTIVE_MULTICROSS", 0x5835fe6d},
+    {"SOLID_REACTIVE_NEXUS", 0xfc68cdfb},
+    {"SOLID_REACTIVE_MULTINEXUS", 0xccf12b31},
+    {"SPLASH", 0xdad627e5},
+    {"MULTISPLASH", 0x530f6a66},
+    {"SOLID_SPLASH", 0x11096449},
+    {"SOLID_MULTISPLASH", 0xe647073a},
+};
+
+// Effects that take their randomness from rand(), which differs between C
+// libraries. These are only checked to be repeatable.
+static const std::set<std::string> random_effects = {"RAINDROPS", "JELLYBEAN_RAINDROPS", "DIGITAL_RAIN"};
+
+class RgbMatrixGolden : public TestFixture {
+   public:
+    // Two seconds of the effect, with hits at the start and after 40 frames.
+    // Writes the frames to QMK_RGB_MATRIX_FRAMES/<effect>_<frame>.ppm if set.
+    uint32_t run_effect(uint8_t mode) {
+        const char* frames_dir = getenv("QMK_RGB_MATRIX_FRAMES");
+        uint32_t    checksum   = 2166136261u;
+        sim.start(mode);
+        sim.hit(0, 0);
+        sim.hit(5, 2);
+        for (unsigned frame = 0; frame < 125; frame++) {
+            if (frame == 40) {
+                sim.hit(9, 3);
+            }
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(sim.step());
+            for (size_t i = 0; i < DRIVER_LED_TOTAL * sizeof(RGB); i++) {
+                checksum = (checksum ^ bytes[i]) * 16777619u;
+            }
+            if (frames_dir) {
+                char name[16];
+                snprintf(name, sizeof(name), "_%03u.ppm", frame);
+                std::string path = std::string(frames_dir) + "/" + RgbMatrixSim::effect_name(mode) + name;
+                EXPECT_TRUE(sim.write_ppm(path)) << "Can't write " << path;
+            }
+        }
+        return checksum;
+    }
+
+    RgbMatrixSim sim;
+};
+
+TEST_F(RgbMatrixGolden, EffectsMatchTheirGoldenFrames) {
+    for (uint8_t mode = 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        std::string name     = RgbMatrixSim::effect_name(mode);
+        uint32_t    checksum = run_effect(mode);
+        if (random_effects.count(name)) {
+            continue;
+        }
+        auto expected = golden.find(name);
+        if (expected == golden.end()) {
+            ADD_FAILURE() << "No golden checksum for " << name << ", it is 0x" << std::hex << checksum;
+            continue;
+        }
+        EXPECT_EQ(checksum, expected->second) << name << " has changed, its checksum is now 0x" << std::hex << checksum;
+    }
+}
+
+TEST_F(RgbMatrixGolden, EffectsAreRepeatable) {
+    for (uint8_t mode = 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        uint32_t checksum = run_effect(mode);
+        EXPECT_EQ(run_effect(mode), checksum) << RgbMatrixSim::effect_name(mode);
+    }
+}
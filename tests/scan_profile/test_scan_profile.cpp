@@ -0,0 +1,84 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+extern "C" {
+extern uint32_t action_work_ms;
+}
+
+// The test timer counts milliseconds, so every stage takes a multiple of 1000us
+class ScanProfile : public TestFixture {
+   protected:
+    ScanProfile() {
+        action_work_ms = 0;
+        scan_profile_reset();
+    }
+};
+
+TEST_F(ScanProfile, IdleLoopsAreCounted) {
+    TestDriver driver;
+    idle_for(10);
+
+    const scan_profile_t *task = scan_profile_get(PROFILE_KEYBOARD_TASK);
+    EXPECT_EQ(task->us.count, 10u);
+    EXPECT_EQ(task->us.min, 0);
+    EXPECT_EQ(task->us.max, 0);
+    EXPECT_EQ(task->histogram[0], 10);
+    EXPECT_EQ(scan_profile_get(PROFILE_MATRIX_SCAN)->us.count, 10u);
+    EXPECT_EQ(scan_profile_get(PROFILE_ACTION_EXEC)->us.count, 10u);
+    // disabled features are never timed
+    EXPECT_EQ(scan_profile_get(PROFILE_RGB_MATRIX)->us.count, 0u);
+}
+
+TEST_F(ScanProfile, StagesAreTimedSeparately) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    action_work_ms = 3;
+    press_key(0, 0);
+    run_one_scan_loop();
+    release_key(0, 0);
+    run_one_scan_loop();
+
+    const scan_profile_t *matrix = scan_profile_get(PROFILE_MATRIX_SCAN);
+    EXPECT_EQ(matrix->us.count, 2u);
+    EXPECT_EQ(matrix->us.max, 0);
+
+    const scan_profile_t *action = scan_profile_get(PROFILE_ACTION_EXEC);
+    EXPECT_EQ(action->us.count, 2u);
+    EXPECT_EQ(action->us.min, 0);
+    EXPECT_EQ(action->us.max, 3000);
+    EXPECT_EQ(sample_stats_average(&action->us), 1500u);
+    // 2048us and up
+    EXPECT_EQ(action->histogram[SCAN_PROFILE_BUCKETS - 1], 1);
+
+    const scan_profile_t *task = scan_profile_get(PROFILE_KEYBOARD_TASK);
+    EXPECT_EQ(task->us.min, 0);
+    EXPECT_EQ(task->us.max, 3000);
+}
+
+TEST_F(ScanProfile, ResetClearsEveryStage) {
+    TestDriver driver;
+    idle_for(3);
+    scan_profile_reset();
+    for (uint8_t stage = 0; stage < PROFILE_STAGES; stage++) {
+        EXPECT_EQ(scan_profile_get(stage)->us.count, 0u);
+        EXPECT_EQ(scan_profile_get(stage)->us.max, 0);
+    }
+}
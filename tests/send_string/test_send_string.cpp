@@ -0,0 +1,128 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringBatched : public TestFixture {};
+
+TEST_F(SendStringBatched, AscendingKeysShareAPressReport) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_H)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E, KC_L)));
+    // the repeated l needs a release in between
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L, KC_O)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    send_string_batched("hello");
+    EXPECT_EQ(driver.keyboard_report_count(), 5u);
+}
+
+TEST_F(SendStringBatched, RepeatedCharactersAreReleasedInBetween) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    send_string_batched("aa");
+}
+
+TEST_F(SendStringBatched, ShiftChangesGetTheirOwnReport) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT, KC_H)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_I)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT, KC_1)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    send_string_batched("Hi!");
+}
+
+TEST_F(SendStringBatched, ShiftedCharactersShareAReport) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT, KC_A, KC_B)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    send_string_batched("AB");
+}
+
+TEST_F(SendStringBatched, GroupsAreLimitedToTheReportSize) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_B, KC_C, KC_D, KC_E, KC_F)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_G, KC_H)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    send_string_batched("abcdefgh");
+}
+
+TEST_F(SendStringBatched, KeyCodesEndTheBatch) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_B)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_ENTER)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_C)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    send_string_batched("ab" SS_TAP(X_ENTER) "c");
+}
+
+TEST_F(SendStringBatched, HeldModifiersStillApply) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL, KC_A, KC_C)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    send_string_batched(SS_LCTRL("ac"));
+}
+
+TEST_F(SendStringBatched, IntervalIsWaitedAfterEveryReport) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(5);
+    uint16_t start = timer_read();
+    send_string_batched_with_delay("hello", 10);
+    EXPECT_EQ(timer_elapsed(start), 50);
+}
+
+TEST_F(SendStringBatched, CharactersCanBeFedOneAtATime) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Q)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_M, KC_K)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    send_string_batch_begin(0);
+    send_string_batch_char('q');
+    send_string_batch_char('k');
+    send_string_batch_char('m');
+    send_string_batch_end();
+}
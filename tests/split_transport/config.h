@@ -0,0 +1,27 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// 6 rows per half, 3 bytes per packed row
+#define MATRIX_ROWS 12
+#define MATRIX_COLS 20
+
+// SPLIT_TRANSPORT = serial_link, as split_common/post_config.h sets it up
+#define MAX_FRAME_SIZE 48
+#define NUM_SLAVES 1
+#define SPLIT_LINK_KEEPALIVE 10
+#define SPLIT_LINK_TIMEOUT 50
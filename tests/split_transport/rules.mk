@@ -0,0 +1,28 @@
+# Copyright 2019 QMK
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+CUSTOM_MATRIX=yes
+VPATH += $(QUANTUM_PATH)/split_common
+SRC += $(QUANTUM_PATH)/split_common/matrix_delta.c \
+       $(QUANTUM_PATH)/split_common/split_scheduler.c \
+       $(QUANTUM_PATH)/split_common/serial_frame.c \
+       $(QUANTUM_PATH)/split_common/split_stats.c \
+       $(QUANTUM_PATH)/split_common/transport_serial_link.c \
+       $(SERIAL_PATH)/protocol/byte_stuffer.c \
+       $(SERIAL_PATH)/protocol/frame_validator.c \
+       $(SERIAL_PATH)/protocol/frame_router.c \
+       $(SERIAL_PATH)/protocol/transport.c \
+       $(SERIAL_PATH)/protocol/triple_buffered_object.c
+OPT_DEFS += -DSPLIT_LINK_STATS_ENABLE
@@ -0,0 +1,230 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <stdlib.h>
+
+extern "C" {
+#include "matrix_delta.h"
+}
+
+// One transaction: the slave builds its message from the last acknowledgement
+// it received, the master applies it and answers with a new one
+class MatrixDelta : public testing::Test {
+  public:
+    MatrixDelta() {
+        split_delta_slave_init(&slave);
+        split_delta_master_init(&master, &ack);
+        memset(matrix, 0, sizeof(matrix));
+    }
+
+    uint8_t prepare() { return split_delta_slave_update(&slave, matrix, &ack, &msg); }
+
+    bool deliver(uint8_t size) { return split_delta_master_apply(&master, &msg, size, &ack); }
+
+    bool exchange() {
+        size = prepare();
+        return deliver(size);
+    }
+
+    void expect_synced() {
+        for (int r = 0; r < ROWS_PER_HAND; r++) {
+            EXPECT_EQ(master.matrix[r], matrix[r]) << "row " << r;
+        }
+    }
+
+    split_delta_slave_t  slave;
+    split_delta_master_t master;
+    split_delta_ack_t    ack;
+    split_delta_msg_t    msg;
+    matrix_row_t         matrix[ROWS_PER_HAND];
+    uint8_t              size;
+};
+
+#define FULL_SIZE (3 + SPLIT_ROW_MAP_BYTES + ROWS_PER_HAND * SPLIT_ROW_BYTES)
+
+TEST(MatrixPacking, RowsUseOnlyTheBytesOfTheirColumns) {
+    matrix_row_t rows[ROWS_PER_HAND] = {0xABCDE, 0x1, 0x80000, 0, 0xFFFFF, 0x12345};
+    matrix_row_t unpacked[ROWS_PER_HAND];
+    uint8_t      packed[ROWS_PER_HAND * SPLIT_ROW_BYTES];
+
+    EXPECT_EQ(SPLIT_ROW_BYTES, 3);
+    split_pack_rows(packed, rows, ROWS_PER_HAND);
+    EXPECT_EQ(packed[0], 0xDE);
+    EXPECT_EQ(packed[1], 0xBC);
+    EXPECT_EQ(packed[2], 0x0A);
+    split_unpack_rows(unpacked, packed, ROWS_PER_HAND);
+    for (int r = 0; r < ROWS_PER_HAND; r++) {
+        EXPECT_EQ(unpacked[r], rows[r]);
+    }
+}
+
+TEST_F(MatrixDelta, StartsWithAFullCopy) {
+    matrix[2] = 0x10;
+    EXPECT_TRUE(exchange());
+    EXPECT_EQ(size, FULL_SIZE);
+    expect_synced();
+}
+
+TEST_F(MatrixDelta, OnlySendsTheGenerationWhileNothingChanges) {
+    EXPECT_TRUE(exchange());
+    for (int i = 0; i < 10; i++) {
+        EXPECT_TRUE(exchange());
+        EXPECT_EQ(size, SPLIT_DELTA_UNCHANGED_SIZE);
+    }
+    expect_synced();
+}
+
+TEST_F(MatrixDelta, SendsOnlyTheChangedRows) {
+    EXPECT_TRUE(exchange());
+    EXPECT_TRUE(exchange());
+
+    matrix[1] = 0x3;
+    matrix[5] = 0x40000;
+    EXPECT_TRUE(exchange());
+    EXPECT_EQ(size, 3 + SPLIT_ROW_MAP_BYTES + 2 * SPLIT_ROW_BYTES);
+    EXPECT_EQ(msg.data[0], (1 << 1) | (1 << 5));
+    expect_synced();
+
+    EXPECT_TRUE(exchange());
+    EXPECT_EQ(size, SPLIT_DELTA_UNCHANGED_SIZE);
+}
+
+TEST_F(MatrixDelta, ChangesAreSentRelativeToTheAcknowledgedState) {
+    EXPECT_TRUE(exchange());
+    EXPECT_TRUE(exchange());
+
+    // the first change never arrives
+    matrix[0] = 0x1;
+    prepare();
+    matrix[3] = 0x2;
+    EXPECT_TRUE(exchange());
+    EXPECT_EQ(msg.data[0], (1 << 0) | (1 << 3));
+    expect_synced();
+}
+
+TEST_F(MatrixDelta, ToleratesTheAcknowledgementLaggingBehind) {
+    EXPECT_TRUE(exchange());
+    EXPECT_TRUE(exchange());
+
+    matrix[4] = 0x8;
+    size = prepare();
+    split_delta_ack_t in_flight = ack;
+    EXPECT_TRUE(deliver(size));
+    // the master already holds this change when it arrives a second time
+    split_delta_ack_t current = ack;
+    ack                       = in_flight;
+    size                      = prepare();
+    ack                       = current;
+    EXPECT_TRUE(deliver(size));
+    expect_synced();
+    EXPECT_FALSE(ack.resync);
+}
+
+TEST_F(MatrixDelta, SendsFullCopiesAfterTheGenerationWrapsWithoutAcknowledgement) {
+    EXPECT_TRUE(exchange());
+    EXPECT_TRUE(exchange());
+    split_delta_ack_t stale = ack;
+
+    // 256 changes while the acknowledgements are lost, the generation is back
+    // to the one the master holds but its matrix is not
+    for (int i = 0; i < 256; i++) {
+        matrix[0] = i & 1 ? 0x5A : 0xA5;
+        ack       = stale;
+        prepare();
+    }
+    EXPECT_EQ(slave.generation, stale.generation);
+    ack = stale;
+    EXPECT_TRUE(exchange());
+    EXPECT_EQ(size, FULL_SIZE);
+    expect_synced();
+
+    // stays with full copies until the master acknowledges another generation
+    EXPECT_TRUE(exchange());
+    EXPECT_EQ(size, FULL_SIZE);
+    matrix[1] = 0x1;
+    EXPECT_TRUE(exchange());
+    EXPECT_EQ(size, FULL_SIZE);
+    EXPECT_TRUE(exchange());
+    EXPECT_EQ(size, SPLIT_DELTA_UNCHANGED_SIZE);
+    matrix[2] = 0x2;
+    EXPECT_TRUE(exchange());
+    EXPECT_EQ(size, 3 + SPLIT_ROW_MAP_BYTES + SPLIT_ROW_BYTES);
+    expect_synced();
+}
+
+TEST_F(MatrixDelta, ResyncsAfterACorruptedRow) {
+    EXPECT_TRUE(exchange());
+    EXPECT_TRUE(exchange());
+
+    matrix[2] = 0x5;
+    size = prepare();
+    msg.data[SPLIT_ROW_MAP_BYTES] ^= 0x4;
+    EXPECT_FALSE(deliver(size));
+    EXPECT_TRUE(ack.resync);
+    EXPECT_TRUE(exchange());
+    EXPECT_EQ(size, FULL_SIZE);
+    expect_synced();
+    EXPECT_FALSE(ack.resync);
+}
+
+TEST_F(MatrixDelta, RejectsTruncatedMessages) {
+    EXPECT_TRUE(exchange());
+    EXPECT_TRUE(exchange());
+
+    matrix[0] = 0x1;
+    size = prepare();
+    EXPECT_FALSE(deliver(size - 1));
+    EXPECT_FALSE(deliver(0));
+    EXPECT_TRUE(exchange());
+    expect_synced();
+}
+
+TEST_F(MatrixDelta, ResyncsPeriodically) {
+    EXPECT_TRUE(exchange());
+    int full = 0;
+    for (int i = 0; i < 3 * SPLIT_TRANSPORT_RESYNC_INTERVAL; i++) {
+        EXPECT_TRUE(exchange());
+        if (size == FULL_SIZE) {
+            full++;
+        }
+    }
+    EXPECT_EQ(full, 3);
+}
+
+TEST_F(MatrixDelta, RecoversFromRandomLinkErrors) {
+    srand(7);
+    for (int i = 0; i < 20000; i++) {
+        if (rand() % 4 == 0) {
+            matrix[rand() % ROWS_PER_HAND] ^= (matrix_row_t)1 << (rand() % MATRIX_COLS);
+        }
+        size     = prepare();
+        int fate = rand() % 16;
+        if (fate == 0) {
+            // lost
+            continue;
+        } else if (fate == 1) {
+            ((uint8_t*)&msg)[rand() % size] ^= 1 << (rand() % 8);
+        }
+        bool ok = deliver(size);
+        if (ok) {
+            expect_synced();
+        }
+    }
+    // a wrong acknowledgement costs one more exchange for the resync
+    EXPECT_TRUE(exchange() || exchange() || exchange());
+    expect_synced();
+}
@@ -0,0 +1,162 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <string.h>
+#include <vector>
+
+extern "C" {
+#include "serial_frame.h"
+}
+
+// Both halves joined by a wire that only holds bytes, like the USART ISRs
+class SerialFrame : public testing::Test {
+  public:
+    SerialFrame() {
+        for (uint8_t i = 0; i < sizeof(request); i++) {
+            request[i] = 0x10 + i;
+        }
+        for (uint8_t i = 0; i < sizeof(response); i++) {
+            response[i] = 0x80 + i;
+        }
+        memset(received_request, 0, sizeof(received_request));
+        memset(received_response, 0, sizeof(received_response));
+    }
+
+    void send(uint8_t header, uint8_t* buffer, uint8_t size, bool length_prefixed) {
+        serial_frame_t frame;
+        int16_t        byte;
+
+        wire.clear();
+        serial_frame_start_send(&frame, header, buffer, size, length_prefixed);
+        while ((byte = serial_frame_next(&frame)) >= 0) {
+            wire.push_back(byte);
+        }
+    }
+
+    // What serial_usart.c does with a request on the target side
+    uint8_t target_receive() {
+        serial_frame_t frame;
+        uint8_t        result = SERIAL_FRAME_MORE;
+
+        serial_frame_start_receive(&frame);
+        for (uint8_t byte : wire) {
+            result = serial_frame_receive(&frame, byte);
+            if (result == SERIAL_FRAME_HEADER) {
+                if ((byte & ~SERIAL_FRAME_TID_MASK) != SERIAL_FRAME_REQUEST) {
+                    return SERIAL_FRAME_CRC_ERROR;
+                }
+                tid = byte & SERIAL_FRAME_TID_MASK;
+                serial_frame_expect(&frame, received_request, sizeof(received_request), false);
+            }
+        }
+        return result;
+    }
+
+    uint8_t initiator_receive(uint8_t size, bool length_prefixed) {
+        serial_frame_t frame;
+        uint8_t        result = SERIAL_FRAME_MORE;
+
+        serial_frame_start_receive(&frame);
+        for (uint8_t byte : wire) {
+            result = serial_frame_receive(&frame, byte);
+            if (result == SERIAL_FRAME_HEADER) {
+                header = byte;
+                serial_frame_expect(&frame, received_response, size, length_prefixed);
+            }
+        }
+        return result;
+    }
+
+    std::vector<uint8_t> wire;
+    uint8_t              request[6];
+    uint8_t              response[10];
+    uint8_t              received_request[6];
+    // one spare byte to catch writes past the buffer
+    uint8_t received_response[11];
+    uint8_t tid    = 0xFF;
+    uint8_t header = 0;
+};
+
+TEST_F(SerialFrame, RoundTripsATransaction) {
+    send(SERIAL_FRAME_REQUEST | 3, request, sizeof(request), false);
+    EXPECT_EQ(wire.size(), 1 + sizeof(request) + 1);
+    EXPECT_EQ(target_receive(), SERIAL_FRAME_DONE);
+    EXPECT_EQ(tid, 3);
+    EXPECT_EQ(memcmp(received_request, request, sizeof(request)), 0);
+
+    send(SERIAL_FRAME_ACK, response, sizeof(response), false);
+    EXPECT_EQ(initiator_receive(sizeof(response), false), SERIAL_FRAME_DONE);
+    EXPECT_EQ(header, SERIAL_FRAME_ACK);
+    EXPECT_EQ(memcmp(received_response, response, sizeof(response)), 0);
+}
+
+TEST_F(SerialFrame, EmptyBuffersOnlySendHeaderAndCrc) {
+    send(SERIAL_FRAME_NAK, response, 0, false);
+    EXPECT_EQ(wire.size(), 2u);
+    EXPECT_EQ(initiator_receive(0, false), SERIAL_FRAME_DONE);
+    EXPECT_EQ(header, SERIAL_FRAME_NAK);
+}
+
+TEST_F(SerialFrame, SendsOnlyThePrefixedLength) {
+    response[0] = 3;
+    send(SERIAL_FRAME_ACK, response, sizeof(response), true);
+    EXPECT_EQ(wire.size(), 1 + 4 + 1u);
+    EXPECT_EQ(initiator_receive(sizeof(response), true), SERIAL_FRAME_DONE);
+    EXPECT_EQ(memcmp(received_response, response, 4), 0);
+    EXPECT_EQ(received_response[4], 0);
+}
+
+TEST_F(SerialFrame, ClampsALengthLargerThanTheBuffer) {
+    response[0] = 200;
+    send(SERIAL_FRAME_ACK, response, sizeof(response), true);
+    EXPECT_EQ(wire.size(), 1 + sizeof(response) + 1);
+    EXPECT_EQ(initiator_receive(sizeof(response), true), SERIAL_FRAME_DONE);
+    EXPECT_EQ(received_response[sizeof(response)], 0);
+
+    // a receiver with a smaller buffer stops at its own size
+    memset(received_response, 0, sizeof(received_response));
+    EXPECT_NE(initiator_receive(4, true), SERIAL_FRAME_DONE);
+    EXPECT_EQ(received_response[4], 0);
+}
+
+TEST_F(SerialFrame, DetectsEverySingleBitError) {
+    send(SERIAL_FRAME_REQUEST | 1, request, sizeof(request), false);
+    std::vector<uint8_t> sent = wire;
+
+    for (size_t i = 0; i < sent.size(); i++) {
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            wire = sent;
+            wire[i] ^= 1 << bit;
+            EXPECT_NE(target_receive(), SERIAL_FRAME_DONE) << "byte " << i << " bit " << (int)bit;
+        }
+    }
+    wire = sent;
+    EXPECT_EQ(target_receive(), SERIAL_FRAME_DONE);
+}
+
+TEST_F(SerialFrame, ALostByteNeverCompletesTheFrame) {
+    send(SERIAL_FRAME_REQUEST, request, sizeof(request), false);
+    std::vector<uint8_t> sent = wire;
+
+    for (size_t i = 0; i < sent.size(); i++) {
+        wire = sent;
+        wire.erase(wire.begin() + i);
+        // without the header the frame is discarded, otherwise the receiver
+        // waits for one more byte until serial_usart.c times out
+        EXPECT_EQ(target_receive(), i == 0 ? SERIAL_FRAME_CRC_ERROR : SERIAL_FRAME_MORE) << "byte " << i;
+    }
+}
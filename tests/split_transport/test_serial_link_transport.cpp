@@ -0,0 +1,270 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+#include "transport.h"
+#include "matrix_delta.h"
+#include "split_stats.h"
+#include "serial_frame.h"
+#include "serial_link/protocol/byte_stuffer.h"
+#include "serial_link/protocol/frame_router.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+// Both halves in one process, the router is switched to the half that runs
+static std::vector<uint8_t> wire[NUM_LINKS];
+// Time the USART driver takes to hand over the received bytes
+static uint32_t receive_ms;
+
+extern "C" {
+void serial_link_usart_init(uint8_t link) {}
+void serial_link_usart_receive(void) { advance_time(receive_ms); }
+
+void send_data(uint8_t link, const uint8_t* data, uint16_t size) { wire[link].insert(wire[link].end(), data, data + size); }
+}
+
+// A scan every SCAN_MS, the slave half driven by a typing trace
+class SerialLinkTransport : public testing::Test {
+  public:
+    static const int SCAN_MS = 1;
+
+    SerialLinkTransport() {
+        set_time(0);
+        receive_ms = 0;
+        wire[UP_LINK].clear();
+        wire[DOWN_LINK].clear();
+        memset(slave_matrix, 0, sizeof(slave_matrix));
+        memset(master_matrix, 0, sizeof(master_matrix));
+        split_link_stats_reset();
+        transport_master_init();
+    }
+
+    // Returns what transport_master() returned
+    bool scan() {
+        router_set_master(false);
+        transport_slave(slave_matrix);
+
+        router_set_master(true);
+        deliver(UP_LINK, DOWN_LINK);
+        bool ok = transport_master(master_matrix);
+
+        router_set_master(false);
+        deliver(DOWN_LINK, UP_LINK);
+
+        advance_time(SCAN_MS);
+        return ok;
+    }
+
+    void deliver(uint8_t from, uint8_t to) {
+        std::vector<uint8_t>& bytes_sent = wire[from];
+        for (size_t i = 0; i < bytes_sent.size(); i++) {
+            uint8_t byte = bytes_sent[i];
+            // a bit error in the last byte before the delimiter, which is never zero
+            if (drop_next_frame && i + 1 < bytes_sent.size() && bytes_sent[i + 1] == 0) {
+                byte ^= byte == 1 ? 2 : 1;
+                drop_next_frame = false;
+            }
+            byte_stuffer_recv_byte(to, byte);
+            if (byte == 0) {
+                frames++;
+            }
+        }
+        bytes += wire[from].size();
+        wire[from].clear();
+    }
+
+    bool in_sync() { return memcmp(slave_matrix, master_matrix, sizeof(slave_matrix)) == 0; }
+
+    matrix_row_t slave_matrix[ROWS_PER_HAND];
+    matrix_row_t master_matrix[ROWS_PER_HAND];
+    bool         drop_next_frame = false;
+    uint32_t     frames          = 0;
+    uint32_t     bytes           = 0;
+};
+
+TEST_F(SerialLinkTransport, DeliversTheSlaveMatrix) {
+    slave_matrix[0] = 0x1;
+    slave_matrix[5] = (matrix_row_t)1 << (MATRIX_COLS - 1);
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(in_sync());
+
+    slave_matrix[0] = 0;
+    slave_matrix[3] = 0x80;
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(in_sync());
+}
+
+TEST_F(SerialLinkTransport, OnlySendsChangesAndKeepalives) {
+    scan();
+    uint32_t sent = frames;
+    for (int n = 1; n < 1000; n++) {
+        scan();
+    }
+    EXPECT_EQ(frames - sent, 1000u / SPLIT_LINK_KEEPALIVE - 1);
+
+    sent = frames;
+    slave_matrix[2] = 0x4;
+    scan();
+    EXPECT_EQ(frames, sent + 1);
+    EXPECT_TRUE(in_sync());
+}
+
+TEST_F(SerialLinkTransport, AKeepaliveReplacesALostFrame) {
+    scan();
+    slave_matrix[1] = 0x2;
+    drop_next_frame = true;
+    int n = 0;
+    while (!in_sync()) {
+        EXPECT_TRUE(scan());
+        n++;
+        ASSERT_LE(n, SPLIT_LINK_KEEPALIVE + 1);
+    }
+    EXPECT_GT(n, 1);
+}
+
+TEST_F(SerialLinkTransport, TimesOutWhenTheSlaveIsGone) {
+    slave_matrix[0] = 0x1;
+    scan();
+    router_set_master(true);
+    for (int t = SCAN_MS; t <= SPLIT_LINK_TIMEOUT; t += SCAN_MS) {
+        EXPECT_TRUE(transport_master(master_matrix));
+        advance_time(SCAN_MS);
+    }
+    EXPECT_FALSE(transport_master(master_matrix));
+
+    const split_link_stats_t* stats = split_link_stats_get();
+    EXPECT_EQ(stats->no_response, 1u);
+
+    // and comes back with the next frame
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(in_sync());
+}
+
+TEST_F(SerialLinkTransport, RecordsTheTimeTheMasterSpendsOnAFrame) {
+    scan();
+    slave_matrix[0] = 0x1;
+    router_set_master(false);
+    transport_slave(slave_matrix);
+    router_set_master(true);
+    deliver(UP_LINK, DOWN_LINK);
+    receive_ms = 2;
+    EXPECT_TRUE(transport_master(master_matrix));
+    EXPECT_EQ(split_link_stats_get()->worst_us, 2000u);
+}
+
+// Bytes of one transaction of the USART backend, as serial_frame.c frames them
+static uint32_t usart_transaction_bytes(uint8_t* m2s, uint8_t m2s_size, uint8_t* s2m, uint8_t s2m_size, bool length_prefixed) {
+    serial_frame_t frame;
+    uint32_t       bytes = 0;
+    serial_frame_start_send(&frame, SERIAL_FRAME_REQUEST, m2s, m2s_size, false);
+    while (serial_frame_next(&frame) >= 0) {
+        bytes++;
+    }
+    serial_frame_start_send(&frame, SERIAL_FRAME_ACK, s2m, s2m_size, length_prefixed);
+    while (serial_frame_next(&frame) >= 0) {
+        bytes++;
+    }
+    return bytes;
+}
+
+// Compares serial_link with the USART backend of serial.c's transaction
+// table, both at 1Mbaud and 10 bits a byte, for a minute of typing at about
+// 8 keys per second.
+//
+// The serial_link bytes are those sent through the mock link. The USART
+// backend runs the matrix transaction every scan; its bytes are the frames
+// serial_frame.c builds for it, with the packed matrix and with
+// SPLIT_TRANSPORT_DELTA messages from matrix_delta.c for the same trace.
+// A key on the slave waits for the master's next scan in all three, plus
+// the time its bytes take on the wire.
+TEST_F(SerialLinkTransport, Benchmark) {
+    const uint32_t scans     = 60000 / SCAN_MS;
+    const uint32_t usart_bps = 1000000;
+
+    split_delta_slave_t  delta_slave;
+    split_delta_master_t delta_master;
+    split_delta_ack_t    ack;
+    split_delta_msg_t    msg;
+    uint8_t              packed[ROWS_PER_HAND * SPLIT_ROW_BYTES];
+    uint8_t              prefixed[1 + sizeof(split_delta_msg_t)];
+    split_delta_slave_init(&delta_slave);
+    split_delta_master_init(&delta_master, &ack);
+
+    srand(7);
+    int      next_event  = 0;
+    uint32_t changes     = 0;
+    uint32_t worst_frame = 0;
+    uint32_t keys_down   = 0;
+    uint32_t full_bytes = 0, full_worst = 0;
+    uint32_t delta_bytes = 0, delta_worst = 0;
+    for (uint32_t n = 0; n < scans; n++) {
+        if ((int)n == next_event) {
+            // press or release a random key, the latter once keys are down
+            uint8_t row = rand() % ROWS_PER_HAND;
+            uint8_t col = rand() % MATRIX_COLS;
+            if (keys_down > 0 && rand() % 2) {
+                for (row = 0; row < ROWS_PER_HAND && slave_matrix[row] == 0; row++) {
+                }
+                slave_matrix[row] &= slave_matrix[row] - 1;
+                keys_down--;
+            } else if (!(slave_matrix[row] & ((matrix_row_t)1 << col))) {
+                slave_matrix[row] |= (matrix_row_t)1 << col;
+                keys_down++;
+            }
+            changes++;
+            next_event += 30 + rand() % 70;
+        }
+
+        split_pack_rows(packed, slave_matrix, ROWS_PER_HAND);
+        uint32_t full = usart_transaction_bytes(NULL, 0, packed, sizeof(packed), false);
+        full_bytes += full;
+        full_worst = std::max(full_worst, full);
+
+        prefixed[0] = split_delta_slave_update(&delta_slave, slave_matrix, &ack, &msg);
+        memcpy(&prefixed[1], &msg, prefixed[0]);
+        uint32_t delta = usart_transaction_bytes((uint8_t*)&ack, sizeof(ack), prefixed, sizeof(prefixed), true);
+        ASSERT_TRUE(split_delta_master_apply(&delta_master, &msg, prefixed[0], &ack));
+        delta_bytes += delta;
+        delta_worst = std::max(delta_worst, delta);
+
+        uint32_t before = bytes;
+        ASSERT_TRUE(scan());
+        ASSERT_TRUE(in_sync()) << "scan " << n;
+        worst_frame = std::max(worst_frame, bytes - before);
+    }
+    EXPECT_EQ(memcmp(delta_master.matrix, slave_matrix, sizeof(slave_matrix)), 0);
+
+    uint32_t scan_us = SCAN_MS * 1000;
+    printf("%u changes in %u scans at %u baud\n", changes, scans, usart_bps);
+    printf("transport          frames  bytes     worst latency\n");
+    printf("usart              %-7u %-9u %u us\n", 2 * scans, full_bytes, scan_us + full_worst * 10 * 1000000 / usart_bps);
+    printf("usart with delta   %-7u %-9u %u us\n", 2 * scans, delta_bytes, scan_us + delta_worst * 10 * 1000000 / usart_bps);
+    printf("serial_link        %-7u %-9u %u us\n", frames, bytes, scan_us + worst_frame * 10 * 1000000 / usart_bps);
+    printf("serial_link with a lost frame: %u us\n", SPLIT_LINK_KEEPALIVE * 1000 + scan_us + worst_frame * 10 * 1000000 / usart_bps);
+
+    // a frame for every change and keepalive, and nothing else
+    EXPECT_LE(frames, changes + scans * SCAN_MS / SPLIT_LINK_KEEPALIVE);
+    // while the USART backend answers every scan, even with deltas
+    EXPECT_LT(bytes, delta_bytes);
+}
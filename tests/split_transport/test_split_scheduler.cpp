@@ -0,0 +1,196 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+#include "split_scheduler.h"
+#include "split_stats.h"
+}
+
+// Simulates the master's transport loop with transfers of known duration
+class SplitScheduler : public testing::Test {
+  public:
+    struct Payload {
+        uint8_t  priority;
+        uint16_t cost_us;
+        // scans between updates, 1 keeps it pending all the time
+        int      period;
+        int      since_pending = -1;
+        int      longest_wait  = 0;
+        int      sent          = 0;
+    };
+
+    SplitScheduler() {
+        split_scheduler_init();
+        split_link_stats_reset();
+    }
+
+    void add(uint8_t priority, uint16_t cost_us, int period) {
+        ASSERT_EQ(split_scheduler_add(priority), (int8_t)payloads.size());
+        Payload p;
+        p.priority = priority;
+        p.cost_us  = cost_us;
+        p.period   = period;
+        payloads.push_back(p);
+    }
+
+    // Returns the time the scan spent on the link
+    uint32_t scan(int n) {
+        uint32_t used = matrix_cost_us;
+        SPLIT_LINK_STATS_RECORD(0, SPLIT_LINK_OK, matrix_bytes, matrix_cost_us);
+
+        split_scheduler_begin_scan();
+        for (uint8_t i = 0; i < payloads.size(); i++) {
+            if (n % payloads[i].period == 0) {
+                split_scheduler_set_pending(i);
+                if (payloads[i].since_pending < 0) {
+                    payloads[i].since_pending = n;
+                }
+            }
+        }
+        int8_t slot;
+        while ((slot = split_scheduler_next(used < SPLIT_TRANSPORT_BUDGET_US ? SPLIT_TRANSPORT_BUDGET_US - used : 0)) >= 0) {
+            Payload& p  = payloads[slot];
+            bool     ok = rand() % 100 >= error_percent;
+            used += p.cost_us;
+            split_scheduler_done(slot, ok, p.cost_us);
+            SPLIT_LINK_STATS_RECORD(1 + slot, ok ? SPLIT_LINK_OK : SPLIT_LINK_DATA_ERROR, p.cost_us / 10, p.cost_us);
+            attempts++;
+            failures += !ok;
+            if (ok) {
+                p.longest_wait  = std::max(p.longest_wait, n - p.since_pending);
+                p.since_pending = -1;
+                p.sent++;
+            }
+        }
+        return used;
+    }
+
+    std::vector<Payload> payloads;
+    uint16_t             matrix_cost_us = 250;
+    uint8_t              matrix_bytes   = 8;
+    uint32_t             attempts       = 0;
+    uint32_t             failures       = 0;
+    int                  error_percent  = 0;
+};
+
+TEST_F(SplitScheduler, SendsEverythingWhenThereIsTime) {
+    add(0, 200, 1);
+    add(1, 100, 1);
+    // the first two scans learn the cost of each
+    scan(0);
+    scan(1);
+    for (int n = 2; n < 100; n++) {
+        EXPECT_EQ(scan(n), matrix_cost_us + 300u);
+    }
+    EXPECT_EQ(payloads[0].sent, 99);
+    EXPECT_EQ(payloads[1].sent, 100);
+}
+
+TEST_F(SplitScheduler, HigherPriorityGoesFirst) {
+    add(0, 500, 1);
+    add(5, 500, 1);
+    scan(0);
+    EXPECT_EQ(payloads[0].sent, 0);
+    EXPECT_EQ(payloads[1].sent, 1);
+    scan(1);
+    scan(2);
+    EXPECT_EQ(payloads[0].sent, 0);
+    EXPECT_EQ(payloads[1].sent, 3);
+    // waiting raises the priority of the other until it goes first
+    for (int n = 3; n < 10; n++) {
+        scan(n);
+    }
+    EXPECT_EQ(payloads[0].sent, 1);
+    EXPECT_EQ(payloads[1].sent, 9);
+}
+
+TEST_F(SplitScheduler, BoundsMatrixLatencyUnderHeavyRgbTraffic) {
+    // rgblight sync on every scan, plus slower state that changes now and then
+    add(0, 400, 1);     // rgblight
+    add(2, 60, 50);     // backlight
+    add(3, 80, 10);     // layer and mods
+    add(1, 1500, 100);  // OLED, larger than the whole budget
+    srand(3);
+    error_percent = 2;
+
+    uint32_t worst = 0, over_budget = 0;
+    for (int n = 0; n < 10000; n++) {
+        uint32_t used = scan(n);
+        worst         = std::max(worst, used);
+        if (used > SPLIT_TRANSPORT_BUDGET_US) {
+            over_budget++;
+            // only a single transfer may exceed the budget
+            EXPECT_EQ(used, matrix_cost_us + 1500u) << "scan " << n;
+        }
+    }
+    printf("worst scan %u us, %u of 10000 scans over budget\n", worst, over_budget);
+    // back to back, a scan could take the matrix plus every payload
+    EXPECT_LT(worst, matrix_cost_us + 400u + 60u + 80u + 1500u);
+    EXPECT_LE(over_budget, 10000u / 100 + 1);
+
+    for (auto& p : payloads) {
+        EXPECT_GT(p.sent, 0);
+        EXPECT_LE(p.longest_wait, SPLIT_SCHEDULER_MAX_WAIT + 2) << "priority " << (int)p.priority;
+    }
+    // rgblight still gets most scans
+    EXPECT_GT(payloads[0].sent, 8000);
+
+    // the link statistics see every transfer and every retry
+    const split_link_stats_t* stats = split_link_stats_get();
+    uint32_t                  bytes = 10000 * matrix_bytes;
+    for (auto& p : payloads) {
+        bytes += p.sent * (p.cost_us / 10);
+    }
+    EXPECT_EQ(stats->transactions, 10000 + attempts);
+    EXPECT_EQ(stats->data_errors, failures);
+    EXPECT_EQ(stats->no_response, 0u);
+    EXPECT_EQ(stats->bytes, bytes);
+    EXPECT_EQ(stats->worst_us, 1500);
+    // each failed transfer is retried, except when it failed in the last scan
+    EXPECT_LE(stats->retries, failures);
+    EXPECT_GE(stats->retries + payloads.size(), failures);
+    EXPECT_GT(failures, 0u);
+}
+
+TEST_F(SplitScheduler, RetriesFailedTransfers) {
+    add(0, 100, 1000);
+    error_percent = 100;
+    scan(0);
+    scan(1);
+    EXPECT_TRUE(split_scheduler_is_pending(0));
+    error_percent = 0;
+    scan(2);
+    EXPECT_FALSE(split_scheduler_is_pending(0));
+    EXPECT_EQ(payloads[0].sent, 1);
+}
+
+TEST_F(SplitScheduler, LearnsTheCostOfTransfers) {
+    add(0, 700, 1);
+    add(0, 700, 1);
+    // a transfer of unknown cost goes alone, then the cost keeps them apart
+    for (int n = 0; n < 4; n++) {
+        EXPECT_EQ(scan(n), matrix_cost_us + 700u);
+    }
+    EXPECT_EQ(split_scheduler_slot(0)->cost_us, 700);
+    EXPECT_EQ(split_scheduler_slot(1)->cost_us, 700);
+    EXPECT_EQ(payloads[0].sent, 2);
+    EXPECT_EQ(payloads[1].sent, 2);
+}
@@ -0,0 +1,75 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_stats.h"
+}
+
+class SplitLinkStats : public testing::Test {
+  public:
+    SplitLinkStats() { split_link_stats_reset(); }
+
+    const split_link_stats_t* stats = split_link_stats_get();
+};
+
+TEST_F(SplitLinkStats, CountsRetriesPerTransaction) {
+    split_link_stats_record(0, SPLIT_LINK_NO_RESPONSE, 10, 120);
+    // a failure of another transaction does not make this one a retry
+    split_link_stats_record(1, SPLIT_LINK_OK, 4, 40);
+    split_link_stats_record(0, SPLIT_LINK_DATA_ERROR, 10, 300);
+    split_link_stats_record(0, SPLIT_LINK_OK, 10, 150);
+    split_link_stats_record(0, SPLIT_LINK_OK, 10, 150);
+
+    EXPECT_EQ(stats->transactions, 5u);
+    EXPECT_EQ(stats->retries, 2u);
+    EXPECT_EQ(stats->no_response, 1u);
+    EXPECT_EQ(stats->data_errors, 1u);
+    EXPECT_EQ(stats->bytes, 24u);
+    EXPECT_EQ(stats->worst_us, 300);
+}
+
+TEST_F(SplitLinkStats, ARejectedMessageIsADataError) {
+    split_link_stats_record(0, SPLIT_LINK_OK, 10, 100);
+    split_link_stats_reject(0);
+    split_link_stats_record(0, SPLIT_LINK_OK, 10, 100);
+
+    EXPECT_EQ(stats->transactions, 2u);
+    EXPECT_EQ(stats->data_errors, 1u);
+    EXPECT_EQ(stats->retries, 1u);
+}
+
+TEST_F(SplitLinkStats, PacksLittleEndianForRawHid) {
+    for (int i = 0; i < 300; i++) {
+        split_link_stats_record(2, SPLIT_LINK_OK, 1, 0x1234);
+    }
+    uint8_t data[32] = {0};
+
+    EXPECT_EQ(split_link_stats_pack(data, SPLIT_LINK_STATS_PACKED_SIZE - 1), 0);
+    EXPECT_EQ(split_link_stats_pack(data, sizeof(data)), SPLIT_LINK_STATS_PACKED_SIZE);
+    // transactions
+    EXPECT_EQ(data[0], 300 & 0xFF);
+    EXPECT_EQ(data[1], 300 >> 8);
+    EXPECT_EQ(data[2], 0);
+    // bytes
+    EXPECT_EQ(data[16], 300 & 0xFF);
+    EXPECT_EQ(data[17], 300 >> 8);
+    // worst_us
+    EXPECT_EQ(data[20], 0x34);
+    EXPECT_EQ(data[21], 0x12);
+    EXPECT_EQ(data[22], 0);
+}
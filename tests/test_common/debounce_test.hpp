@@ -0,0 +1,83 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "quantum.h"
+#include "debounce.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+// One key of a bounce trace. Every character of the trace is a raw sample
+// taken one millisecond after the previous one, '-' is down and '_' is up.
+struct KeyTrace {
+    uint8_t     row;
+    uint8_t     col;
+    std::string trace;
+};
+
+class DebounceTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        memset(raw, 0, sizeof(raw));
+        memset(cooked, 0, sizeof(cooked));
+        debounce_init(MATRIX_ROWS);
+    }
+
+    // Runs the debounce algorithm over the traces, and returns the debounced
+    // state of each key in the same format.
+    std::vector<std::string> replay(const std::vector<KeyTrace>& keys) {
+        std::vector<std::string> output(keys.size());
+        size_t                   length = 0;
+        for (auto& key : keys) {
+            length = std::max(length, key.trace.size());
+        }
+
+        for (size_t t = 0; t < length; t++) {
+            matrix_row_t previous[MATRIX_ROWS];
+            memcpy(previous, raw, sizeof(raw));
+            for (auto& key : keys) {
+                if (t < key.trace.size()) {
+                    if (key.trace[t] == '-') {
+                        raw[key.row] |= (matrix_row_t)1 << key.col;
+                    } else {
+                        raw[key.row] &= ~((matrix_row_t)1 << key.col);
+                    }
+                }
+            }
+            debounce(raw, cooked, MATRIX_ROWS, memcmp(previous, raw, sizeof(raw)) != 0);
+            for (size_t k = 0; k < keys.size(); k++) {
+                bool down = cooked[keys[k].row] & ((matrix_row_t)1 << keys[k].col);
+                output[k] += down ? '-' : '_';
+            }
+            advance_time(1);
+        }
+        return output;
+    }
+
+    std::string replay(const std::string& trace) { return replay({{0, 0, trace}})[0]; }
+
+    matrix_row_t raw[MATRIX_ROWS];
+    matrix_row_t cooked[MATRIX_ROWS];
+};
@@ -28,6 +28,8 @@ public:
     TestDriver();
     ~TestDriver();
     void set_leds(uint8_t leds) { m_leds = leds; }
+    // keyboard reports that reached the driver so far
+    uint32_t keyboard_report_count() const { return m_keyboard_reports; }
     
     MOCK_METHOD1(send_keyboard_mock, void (report_keyboard_t&));
     MOCK_METHOD1(send_mouse_mock, void (report_mouse_t&));
@@ -41,6 +43,7 @@ private:
     static void send_consumer(uint16_t data);
     host_driver_t m_driver;
     uint8_t m_leds = 0;
+    uint32_t m_keyboard_reports = 0;
     static TestDriver* m_this;
 };
 
@@ -0,0 +1,140 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <stdlib.h>
+
+extern "C" {
+#include "ws2812_parallel.h"
+}
+
+#define MAX_SLOTS 8
+
+// Reads back the bytes a strip receives from the planes
+static void decode(const uint8_t* planes, uint16_t slots, uint8_t bytes_per_led, uint8_t pinmask, uint8_t* out) {
+    for (uint16_t i = 0; i < slots * bytes_per_led; i++) {
+        uint8_t byte = 0;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            byte = (byte << 1) | ((planes[i * 8 + bit] & pinmask) ? 1 : 0);
+        }
+        out[i] = byte;
+    }
+}
+
+TEST(WS2812Parallel, SingleStripSendsMostSignificantBitFirst) {
+    const uint8_t        leds[]   = {0xA5, 0x01, 0x80};
+    const ws2812_strip_t strips[] = {{1 << 3, 0, 1}};
+    uint8_t              planes[MAX_SLOTS * 3 * 8];
+
+    EXPECT_EQ(ws2812_parallel_encode(planes, leds, 1, 3, strips, 1, MAX_SLOTS), 1);
+    const uint8_t expected[24] = {
+        8, 0, 8, 0, 0, 8, 0, 8,  // 0xA5
+        0, 0, 0, 0, 0, 0, 0, 8,  // 0x01
+        8, 0, 0, 0, 0, 0, 0, 0,  // 0x80
+    };
+    for (int i = 0; i < 24; i++) {
+        EXPECT_EQ(planes[i], expected[i]) << "plane " << i;
+    }
+}
+
+TEST(WS2812Parallel, StripsShareThePlanes) {
+    // two strips of one LED, each byte only differs in the strip's pin
+    const uint8_t        leds[]   = {0xFF, 0x00, 0x0F, 0x00, 0xFF, 0xF0};
+    const ws2812_strip_t strips[] = {{1 << 0, 0, 1}, {1 << 5, 1, 1}};
+    uint8_t              planes[MAX_SLOTS * 3 * 8];
+
+    EXPECT_EQ(ws2812_parallel_encode(planes, leds, 2, 3, strips, 2, MAX_SLOTS), 1);
+    for (int bit = 0; bit < 8; bit++) {
+        EXPECT_EQ(planes[0 * 8 + bit], 0x01) << "bit " << bit;
+        EXPECT_EQ(planes[1 * 8 + bit], 0x20) << "bit " << bit;
+        EXPECT_EQ(planes[2 * 8 + bit], bit < 4 ? 0x20 : 0x01) << "bit " << bit;
+    }
+}
+
+TEST(WS2812Parallel, ShortStripsArePaddedWithZeros) {
+    uint8_t leds[5 * 3];
+    memset(leds, 0xFF, sizeof(leds));
+    const ws2812_strip_t strips[] = {{1 << 0, 0, 4}, {1 << 1, 4, 1}};
+    uint8_t              planes[MAX_SLOTS * 3 * 8];
+
+    EXPECT_EQ(ws2812_parallel_encode(planes, leds, 5, 3, strips, 2, MAX_SLOTS), 4);
+    for (int i = 0; i < 4 * 3 * 8; i++) {
+        EXPECT_EQ(planes[i], i < 3 * 8 ? 0x03 : 0x01) << "plane " << i;
+    }
+}
+
+TEST(WS2812Parallel, StripsAreCutOffAtMaxSlotsAndLedsTotal) {
+    uint8_t leds[MAX_SLOTS * 2 * 3];
+    memset(leds, 0xFF, sizeof(leds));
+    // the first strip is longer than MAX_SLOTS, the second runs past the LEDs passed
+    // and the third starts after them
+    const ws2812_strip_t strips[] = {{1 << 0, 0, MAX_SLOTS + 2}, {1 << 1, MAX_SLOTS + 2, 4}, {1 << 2, 20, 2}};
+    uint8_t              planes[MAX_SLOTS * 3 * 8 + 1];
+    planes[MAX_SLOTS * 3 * 8] = 0x5A;
+
+    EXPECT_EQ(ws2812_parallel_encode(planes, leds, MAX_SLOTS + 4, 3, strips, 3, MAX_SLOTS), MAX_SLOTS);
+    for (int i = 0; i < MAX_SLOTS * 3 * 8; i++) {
+        EXPECT_EQ(planes[i], i < 2 * 3 * 8 ? 0x03 : 0x01) << "plane " << i;
+    }
+    EXPECT_EQ(planes[MAX_SLOTS * 3 * 8], 0x5A);
+}
+
+TEST(WS2812Parallel, RoundTripsRgbwLeds) {
+    const uint8_t        bytes_per_led = 4;
+    const ws2812_strip_t strips[]      = {{1 << 0, 0, 3}, {1 << 2, 3, 8}, {1 << 4, 11, 5}, {1 << 7, 16, 8}};
+    uint8_t              leds[24 * bytes_per_led];
+    uint8_t              planes[MAX_SLOTS * bytes_per_led * 8];
+    uint8_t              out[MAX_SLOTS * bytes_per_led];
+
+    srand(1);
+    for (auto& byte : leds) {
+        byte = rand();
+    }
+    uint16_t slots = ws2812_parallel_encode(planes, leds, 24, bytes_per_led, strips, 4, MAX_SLOTS);
+    EXPECT_EQ(slots, 8);
+    for (const auto& strip : strips) {
+        decode(planes, slots, bytes_per_led, strip.pinmask, out);
+        for (uint16_t i = 0; i < slots * bytes_per_led; i++) {
+            uint8_t expected = i < strip.count * bytes_per_led ? leds[strip.start * bytes_per_led + i] : 0;
+            EXPECT_EQ(out[i], expected) << "strip " << (int)strip.pinmask << " byte " << i;
+        }
+    }
+}
+
+TEST(WS2812Parallel, UnevenStripsSendEveryLed) {
+    // the Parallel Output example of feature_rgblight.md: 60 LEDs on { 24, 24, 12 },
+    // planes sized by WS2812_PARALLEL_MAX_LEDS 24
+    const uint8_t        bytes_per_led = 3;
+    const uint16_t       max_leds      = 24;
+    const ws2812_strip_t strips[]      = {{1 << 0, 0, 24}, {1 << 1, 24, 24}, {1 << 2, 48, 12}};
+    uint8_t              leds[60 * bytes_per_led];
+    uint8_t              planes[max_leds * bytes_per_led * 8];
+    uint8_t              out[max_leds * bytes_per_led];
+
+    srand(2);
+    for (auto& byte : leds) {
+        byte = rand();
+    }
+    uint16_t slots = ws2812_parallel_encode(planes, leds, 60, bytes_per_led, strips, 3, max_leds);
+    EXPECT_EQ(slots, 24);
+    for (const auto& strip : strips) {
+        decode(planes, slots, bytes_per_led, strip.pinmask, out);
+        for (uint16_t i = 0; i < slots * bytes_per_led; i++) {
+            uint8_t expected = i < strip.count * bytes_per_led ? leds[strip.start * bytes_per_led + i] : 0;
+            EXPECT_EQ(out[i], expected) << "strip " << (int)strip.pinmask << " byte " << i;
+        }
+    }
+}
@@ -23,6 +23,7 @@ TMK_COMMON_SRC +=	$(COMMON_DIR)/host.c \
 	$(COMMON_DIR)/report.c \
 	$(PLATFORM_COMMON_DIR)/suspend.c \
 	$(PLATFORM_COMMON_DIR)/timer.c \
+	$(COMMON_DIR)/timer_ticks.c \
 	$(PLATFORM_COMMON_DIR)/bootloader.c \
 
 ifeq ($(PLATFORM),AVR)
@@ -125,6 +126,16 @@ else
     TMK_COMMON_DEFS += -DNO_DEBUG
 endif
 
+ifeq ($(strip $(SCAN_PROFILE_ENABLE)), yes)
+    TMK_COMMON_SRC += $(COMMON_DIR)/scan_profile.c
+    TMK_COMMON_DEFS += -DSCAN_PROFILE_ENABLE
+endif
+
+ifeq ($(strip $(LATENCY_TRACE_ENABLE)), yes)
+    TMK_COMMON_SRC += $(COMMON_DIR)/latency_trace.c
+    TMK_COMMON_DEFS += -DLATENCY_TRACE_ENABLE
+endif
+
 ifeq ($(strip $(COMMAND_ENABLE)), yes)
     TMK_COMMON_SRC += $(COMMON_DIR)/command.c
     TMK_COMMON_DEFS += -DCOMMAND_ENABLE
@@ -27,6 +27,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "action_util.h"
 #include "action.h"
 #include "wait.h"
+#include "latency_trace.h"
 
 #ifdef DEBUG_ACTION
 #include "debug.h"
@@ -173,6 +174,8 @@ void process_record(keyrecord_t *record)
 {
     if (IS_NOEVENT(record->event)) { return; }
 
+    LATENCY_TRACE_EVENT(record->event.time);
+
     if(!process_record_quantum(record))
         return;
 
@@ -518,6 +521,7 @@ void process_action(keyrecord_t *record, action_t action)
                         if (tap_count > 0) {
                             dprint("KEYMAP_TAP_KEY: Tap: unregister_code\n");
                             if (action.layer_tap.code == KC_CAPS) {
+                                host_keyboard_flush();
                                 wait_ms(80);
                             }
                             unregister_code(action.layer_tap.code);
@@ -711,6 +715,7 @@ void register_code(uint8_t code)
 #endif
         add_key(KC_CAPSLOCK);
         send_keyboard_report();
+        host_keyboard_flush();
         wait_ms(100);
         del_key(KC_CAPSLOCK);
         send_keyboard_report();
@@ -722,6 +727,7 @@ void register_code(uint8_t code)
 #endif
         add_key(KC_NUMLOCK);
         send_keyboard_report();
+        host_keyboard_flush();
         wait_ms(100);
         del_key(KC_NUMLOCK);
         send_keyboard_report();
@@ -733,6 +739,7 @@ void register_code(uint8_t code)
 #endif
         add_key(KC_SCROLLLOCK);
         send_keyboard_report();
+        host_keyboard_flush();
         wait_ms(100);
         del_key(KC_SCROLLLOCK);
         send_keyboard_report();
@@ -854,6 +861,7 @@ void unregister_code(uint8_t code)
 void tap_code(uint8_t code) {
   register_code(code);
   #if TAP_CODE_DELAY > 0
+    host_keyboard_flush();
     wait_ms(TAP_CODE_DELAY);
   #endif
   unregister_code(code);
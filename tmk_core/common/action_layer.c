@@ -1,4 +1,5 @@
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "action.h"
 #include "util.h"
@@ -220,9 +221,33 @@ void layer_debug(void) {
 #endif
 
 #if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
+#ifdef SOURCE_LAYERS_CACHE_BYTES
 /** \brief source layer cache
+ *
+ * One byte per key holding the layer it was pressed on
  */
+uint8_t source_layers_cache[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 
+/** \brief update source layers cache
+ *
+ * Updates the cached keys when changing layers
+ */
+void update_source_layers_cache(keypos_t key, uint8_t layer) {
+  source_layers_cache[key.row][key.col] = layer;
+}
+
+/** \brief read source layers cache
+ *
+ * reads the cached keys stored when the layer was changed
+ */
+uint8_t read_source_layers_cache(keypos_t key) {
+  return source_layers_cache[key.row][key.col];
+}
+#else
+/** \brief source layer cache
+ *
+ * One bit-plane per bit of the layer number, eight keys per byte
+ */
 uint8_t source_layers_cache[(MATRIX_ROWS * MATRIX_COLS + 7) / 8][MAX_LAYER_BITS] = {{0}};
 
 /** \brief update source layers cache
@@ -262,6 +287,7 @@ uint8_t read_source_layers_cache(keypos_t key) {
   return layer;
 }
 #endif
+#endif
 
 /** \brief Store or get action (FIXME: Needs better summary)
  *
@@ -292,11 +318,11 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 }
 
 
-/** \brief Layer switch get layer
+/** \brief Layer switch find layer
  *
- * Gets the layer based on key info
+ * Walks the active layers from the top down to find the layer providing the key
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
+static uint8_t layer_switch_find_layer(keypos_t key) {
 #ifndef NO_ACTION_LAYER
   action_t action;
   action.code = ACTION_TRANSPARENT;
@@ -318,6 +344,61 @@ uint8_t layer_switch_get_layer(keypos_t key) {
 #endif
 }
 
+#ifdef LAYER_LOOKUP_CACHE
+/** \brief layer lookup cache
+ *
+ * Holds the resolved layer of every key for the layer mask in layer_cache_state.
+ * Keys are resolved lazily, on their first lookup after the mask has changed.
+ */
+static uint8_t layer_cache[MATRIX_ROWS * MATRIX_COLS];
+static uint8_t layer_cache_resolved[(MATRIX_ROWS * MATRIX_COLS + 7) / 8];
+static uint32_t layer_cache_state;
+
+/** \brief Layer cache invalidate
+ *
+ * Forgets every resolved key, call this after changing the keymap itself (eg dynamic keymaps)
+ */
+void layer_cache_invalidate(void) {
+  memset(layer_cache_resolved, 0, sizeof(layer_cache_resolved));
+}
+
+/** \brief Layer cache lookup
+ *
+ * Returns the cached layer for key, resolving it first if it is stale
+ */
+static uint8_t layer_cache_lookup(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+  const uint32_t layers = layer_state | default_layer_state;
+#else
+  const uint32_t layers = default_layer_state;
+#endif
+  if (layers != layer_cache_state) {
+    layer_cache_invalidate();
+    layer_cache_state = layers;
+  }
+
+  const uint16_t key_number = key.col + (key.row * MATRIX_COLS);
+  const uint8_t storage_bit = 1U << (key_number % 8);
+  if (!(layer_cache_resolved[key_number / 8] & storage_bit)) {
+    layer_cache[key_number] = layer_switch_find_layer(key);
+    layer_cache_resolved[key_number / 8] |= storage_bit;
+  }
+  return layer_cache[key_number];
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifdef LAYER_LOOKUP_CACHE
+  return layer_cache_lookup(key);
+#else
+  return layer_switch_find_layer(key);
+#endif
+}
+
 /** \brief Layer switch get layer
  *
  * Gets action code based on key position
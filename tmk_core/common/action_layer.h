@@ -91,11 +91,24 @@ uint32_t layer_state_set_kb(uint32_t state);
 #if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
 /* The number of bits needed to represent the layer number: log2(32). */
 #define MAX_LAYER_BITS 5
+/* Store one byte per key where RAM allows, bit-planes on AVR */
+#if !defined(SOURCE_LAYERS_CACHE_BYTES) && !defined(SOURCE_LAYERS_CACHE_BITPLANES)
+#  ifndef __AVR__
+#    define SOURCE_LAYERS_CACHE_BYTES
+#  endif
+#endif
 void update_source_layers_cache(keypos_t key, uint8_t layer);
 uint8_t read_source_layers_cache(keypos_t key);
 #endif
 action_t store_or_get_action(bool pressed, keypos_t key);
 
+#ifdef LAYER_LOOKUP_CACHE
+/* mark the resolved layers stale after the keymap contents change */
+void layer_cache_invalidate(void);
+#else
+#define layer_cache_invalidate()
+#endif
+
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
@@ -17,6 +17,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "action.h"
 #include "action_util.h"
 #include "action_macro.h"
+#include "host.h"
 #include "wait.h"
 
 #ifdef DEBUG_ACTION
@@ -64,6 +65,7 @@ void action_macro_play(const macro_t *macro_p)
             case WAIT:
                 MACRO_READ();
                 dprintf("WAIT(%u)\n", macro);
+                host_keyboard_flush();
                 { uint8_t ms = macro; while (ms--) wait_ms(1); }
                 break;
             case INTERVAL:
@@ -83,6 +85,9 @@ void action_macro_play(const macro_t *macro_p)
                 return;
         }
         // interval
+        if (interval) {
+            host_keyboard_flush();
+        }
         { uint8_t ms = interval; while (ms--) wait_ms(1); }
     }
 }
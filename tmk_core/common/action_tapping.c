@@ -24,19 +24,56 @@ uint16_t get_tapping_term(uint16_t keycode) {
   return TAPPING_TERM;
 }
 
+__attribute__ ((weak))
+bool get_permissive_hold(uint16_t keycode) {
+#ifdef PERMISSIVE_HOLD
+  return true;
+#else
+  return false;
+#endif
+}
+
 #ifdef TAPPING_TERM_PER_KEY
 #define WITHIN_TAPPING_TERM(e)  (TIMER_DIFF_16(e.time, tapping_key.event.time) < get_tapping_term(get_event_keycode(tapping_key.event)))
 #else
 #define WITHIN_TAPPING_TERM(e)  (TIMER_DIFF_16(e.time, tapping_key.event.time) < TAPPING_TERM)
 #endif
 
+#define WAITING_BUFFER_MASK     (WAITING_BUFFER_SIZE - 1)
+
 static keyrecord_t tapping_key = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t waiting_buffer_head = 0;
 static uint8_t waiting_buffer_tail = 0;
 
+/** \brief Hold on typed key
+ *
+ * Whether a key pressed and released while the tapping key is held settles
+ * the tapping key as a hold right away, instead of waiting for the tapping
+ * key to be released or TAPPING_TERM to run out.
+ */
+static inline bool hold_on_typed_key(void)
+{
+#if defined(PERMISSIVE_HOLD_PER_KEY)
+    if (get_permissive_hold(get_event_keycode(tapping_key.event))) return true;
+#endif
+    // With TAPPING_TERM_PER_KEY only the term of the key decides, even when
+    // PERMISSIVE_HOLD is defined
+#if defined(TAPPING_TERM_PER_KEY)
+    return get_tapping_term(get_event_keycode(tapping_key.event)) >= 500;
+#elif defined(PERMISSIVE_HOLD) && !defined(PERMISSIVE_HOLD_PER_KEY)
+    return true;
+#elif !defined(PER_KEY_TAPPING_TERM) && TAPPING_TERM >= 500
+    return true;
+#else
+    return false;
+#endif
+}
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_process(void);
+static bool waiting_buffer_resolve(void);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -56,27 +93,23 @@ void action_tapping_process(keyrecord_t record)
             debug("processed: "); debug_record(record); debug("\n");
         }
     } else {
-        if (!waiting_buffer_enq(record)) {
-            // clear all in case of overflow.
-            debug("OVERFLOW: CLEAR ALL STATES\n");
-            clear_keyboard();
-            waiting_buffer_clear();
-            tapping_key = (keyrecord_t){};
+        while (!waiting_buffer_enq(record)) {
+            // make room by settling the tapping key rather than dropping the event
+            if (!waiting_buffer_resolve()) {
+                // clear all if nothing can be settled
+                debug("OVERFLOW: CLEAR ALL STATES\n");
+                clear_keyboard();
+                waiting_buffer_clear();
+                tapping_key = (keyrecord_t){};
+                break;
+            }
         }
     }
 
-    // process waiting_buffer
     if (!IS_NOEVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         debug("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            debug("processed: waiting_buffer["); debug_dec(waiting_buffer_tail); debug("] = ");
-            debug_record(waiting_buffer[waiting_buffer_tail]); debug("\n\n");
-        } else {
-            break;
-        }
-    }
+    waiting_buffer_process();
     if (!IS_NOEVENT(record.event)) {
         debug("\n");
     }
@@ -106,6 +139,13 @@ bool process_tapping(keyrecord_t *keyp)
 
                     // copy tapping state
                     keyp->tap = tapping_key.tap;
+                    if (tapping_key.tap.count == 0) {
+                        // the action cancelled the tap (interrupted mod tap), so
+                        // it was a hold and the keys typed meanwhile can go out now
+                        debug("Tapping: End. Tap cancelled by interrupt.\n");
+                        tapping_key = (keyrecord_t){};
+                        debug_tapping_key();
+                    }
                     // enqueue
                     return false;
                 }
@@ -113,12 +153,8 @@ bool process_tapping(keyrecord_t *keyp)
                  * This can register the key before settlement of tapping,
                  * useful for long TAPPING_TERM but may prevent fast typing.
                  */
-#if defined(TAPPING_TERM_PER_KEY) || (!defined(PER_KEY_TAPPING_TERM) && TAPPING_TERM >= 500) || defined(PERMISSIVE_HOLD)
-#ifdef TAPPING_TERM_PER_KEY
-                else if ( ( get_tapping_term(get_event_keycode(tapping_key.event)) >= 500) && IS_RELEASED(event) && waiting_buffer_typed(event))
-#else
-                else if ( IS_RELEASED(event) && waiting_buffer_typed(event))
-#endif
+#if defined(TAPPING_TERM_PER_KEY) || (!defined(PER_KEY_TAPPING_TERM) && TAPPING_TERM >= 500) || defined(PERMISSIVE_HOLD) || defined(PERMISSIVE_HOLD_PER_KEY)
+                else if (IS_RELEASED(event) && waiting_buffer_typed(event) && hold_on_typed_key())
                 {
                     debug("Tapping: End. No tap. Interfered by typing key\n");
                     process_record(&tapping_key);
@@ -317,18 +353,54 @@ bool waiting_buffer_enq(keyrecord_t record)
         return true;
     }
 
-    if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
+    if (((waiting_buffer_head + 1) & WAITING_BUFFER_MASK) == waiting_buffer_tail) {
         debug("waiting_buffer_enq: Over flow.\n");
         return false;
     }
 
     waiting_buffer[waiting_buffer_head] = record;
-    waiting_buffer_head = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    waiting_buffer_head = (waiting_buffer_head + 1) & WAITING_BUFFER_MASK;
 
     debug("waiting_buffer_enq: "); debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer process
+ *
+ * Passes buffered events to process_tapping() in order, until one is held
+ * back again.
+ */
+void waiting_buffer_process(void)
+{
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) & WAITING_BUFFER_MASK) {
+        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
+            debug("processed: waiting_buffer["); debug_dec(waiting_buffer_tail); debug("] = ");
+            debug_record(waiting_buffer[waiting_buffer_tail]); debug("\n\n");
+        } else {
+            break;
+        }
+    }
+}
+
+/** \brief Waiting buffer resolve
+ *
+ * Called when the buffer is full. Settles an undecided tapping key as a hold,
+ * as if TAPPING_TERM had run out, and processes what it held back. Returns
+ * false if there was nothing to settle.
+ */
+bool waiting_buffer_resolve(void)
+{
+    if (!IS_TAPPING_PRESSED() || tapping_key.tap.count != 0) {
+        return false;
+    }
+    debug("Tapping: End. Waiting buffer full, settled as hold.\n");
+    process_record(&tapping_key);
+    tapping_key = (keyrecord_t){};
+    debug_tapping_key();
+    waiting_buffer_process();
+    return true;
+}
+
 /** \brief Waiting buffer clear
  *
  * FIXME: Needs docs
@@ -345,7 +417,7 @@ void waiting_buffer_clear(void)
  */
 bool waiting_buffer_typed(keyevent_t event)
 {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) & WAITING_BUFFER_MASK) {
         if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed !=  waiting_buffer[i].event.pressed) {
             return true;
         }
@@ -360,7 +432,7 @@ bool waiting_buffer_typed(keyevent_t event)
 __attribute__((unused))
 bool waiting_buffer_has_anykey_pressed(void)
 {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) & WAITING_BUFFER_MASK) {
         if (waiting_buffer[i].event.pressed) return true;
     }
     return false;
@@ -377,13 +449,13 @@ void waiting_buffer_scan_tap(void)
     // invalid state: tapping_key released && tap.count == 0
     if (!tapping_key.event.pressed) return;
 
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) & WAITING_BUFFER_MASK) {
         if (IS_TAPPING_KEY(waiting_buffer[i].event.key) &&
                 !waiting_buffer[i].event.pressed &&
                 WITHIN_TAPPING_TERM(waiting_buffer[i].event)) {
             tapping_key.tap.count = 1;
-            waiting_buffer[i].tap.count = 1;
             process_record(&tapping_key);
+            waiting_buffer[i].tap = tapping_key.tap;
 
             debug("waiting_buffer_scan_tap: found at ["); debug_dec(i); debug("]\n");
             debug_waiting_buffer();
@@ -409,7 +481,7 @@ static void debug_tapping_key(void)
 static void debug_waiting_buffer(void)
 {
     debug("{ ");
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) & WAITING_BUFFER_MASK) {
         debug("["); debug_dec(i); debug("]="); debug_record(waiting_buffer[i]); debug(" ");
     }
     debug("}\n");
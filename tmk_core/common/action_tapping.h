@@ -31,12 +31,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define TAPPING_TOGGLE  5
 #endif
 
+/* number of key events held back while a tap key is undecided, one slot
+ * is kept free so the usable size is one less */
+#ifndef WAITING_BUFFER_SIZE
 #define WAITING_BUFFER_SIZE 8
+#endif
+
+#if WAITING_BUFFER_SIZE < 2 || WAITING_BUFFER_SIZE > 128 || (WAITING_BUFFER_SIZE & (WAITING_BUFFER_SIZE - 1))
+#error "WAITING_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
 
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_event_keycode(keyevent_t event);
 uint16_t get_tapping_term(uint16_t keycode);
+bool get_permissive_hold(uint16_t keycode);
 void action_tapping_process(keyrecord_t record);
 #endif
 
@@ -40,6 +40,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "mousekey.h"
 #endif
 
+#ifdef SCAN_PROFILE_ENABLE
+#include "scan_profile.h"
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+#include "latency_trace.h"
+#endif
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+#include "split_stats.h"
+#endif
+
 #ifdef PROTOCOL_PJRC
 	#include "usb_keyboard.h"
 		#ifdef EXTRAKEY_ENABLE
@@ -170,6 +182,18 @@ static void command_common_help(void)
 #ifdef SLEEP_LED_ENABLE
 		STR(MAGIC_KEY_SLEEP_LED   ) ":	Sleep LED Test\n"
 #endif
+
+#ifdef SCAN_PROFILE_ENABLE
+		STR(MAGIC_KEY_PROFILE     ) ":	Print and Reset Scan Profile\n"
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+		STR(MAGIC_KEY_LATENCY     ) ":	Print and Reset Key Latency\n"
+#endif
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+		STR(MAGIC_KEY_SPLIT_STATS ) ":	Print and Reset Split Link Statistics\n"
+#endif
     );
 }
 
@@ -324,6 +348,33 @@ static bool command_common(uint8_t code)
             break;
 #endif
 
+#ifdef SCAN_PROFILE_ENABLE
+
+		// print keyboard_task timings and start over
+        case MAGIC_KC(MAGIC_KEY_PROFILE):
+            scan_profile_print();
+            scan_profile_reset();
+            break;
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+
+		// print key to report latencies and start over
+        case MAGIC_KC(MAGIC_KEY_LATENCY):
+            latency_trace_print();
+            latency_trace_reset();
+            break;
+#endif
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+
+		// print split transport counters and start over
+        case MAGIC_KC(MAGIC_KEY_SPLIT_STATS):
+            split_link_stats_print();
+            split_link_stats_reset();
+            break;
+#endif
+
 		// print stored eeprom config
         case MAGIC_KC(MAGIC_KEY_EEPROM):
             print("eeconfig:\n");
@@ -154,6 +154,18 @@ bool command_proc(uint8_t code);
 #define MAGIC_KEY_NKRO           N
 #endif
 
+#ifndef MAGIC_KEY_PROFILE
+#define MAGIC_KEY_PROFILE        P
+#endif
+
+#ifndef MAGIC_KEY_LATENCY
+#define MAGIC_KEY_LATENCY        T
+#endif
+
+#ifndef MAGIC_KEY_SPLIT_STATS
+#define MAGIC_KEY_SPLIT_STATS    L
+#endif
+
 #ifndef MAGIC_KEY_SLEEP_LED
 #define MAGIC_KEY_SLEEP_LED      Z
 
@@ -16,11 +16,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 //#include <avr/interrupt.h>
 #include "keycode.h"
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "latency_trace.h"
 
 #ifdef NKRO_ENABLE
   #include "keycode_config.h"
@@ -31,10 +33,23 @@ static host_driver_t *driver;
 static uint16_t last_system_report = 0;
 static uint16_t last_consumer_report = 0;
 
+#ifdef KEYBOARD_REPORT_COALESCE
+static report_keyboard_t sent_report;   // what the host has
+static report_keyboard_t staged_report; // what it gets at the next flush
+static bool sent_report_valid = false;
+static bool report_staged = false;
+#endif
+
 
 void host_set_driver(host_driver_t *d)
 {
     driver = d;
+#ifdef KEYBOARD_REPORT_COALESCE
+    // a new driver has not seen any report
+    memset(&sent_report, 0, sizeof(sent_report));
+    sent_report_valid = false;
+    report_staged = false;
+#endif
 }
 
 host_driver_t *host_get_driver(void)
@@ -47,6 +62,112 @@ uint8_t host_keyboard_leds(void)
     if (!driver) return 0;
     return (*driver->keyboard_leds)();
 }
+static void send_keyboard(report_keyboard_t *report)
+{
+    (*driver->send_keyboard)(report);
+    LATENCY_TRACE_REPORT();
+
+    if (debug_keyboard) {
+        dprint("keyboard_report: ");
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_SIZE; i++) {
+            dprintf("%02X ", report->raw[i]);
+        }
+        dprint("\n");
+    }
+}
+
+#ifdef KEYBOARD_REPORT_COALESCE
+static uint8_t report_mods(report_keyboard_t *report)
+{
+#ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) return report->nkro.mods;
+#endif
+    return report->mods;
+}
+
+static bool report_has_key(report_keyboard_t *report, uint8_t code)
+{
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == code) return true;
+    }
+    return false;
+}
+
+/** \brief Keys changed twice
+ *
+ * Whether some key changed from sent to staged and changes back in next.
+ * Only keys of sent and staged can do that.
+ */
+static bool keys_changed_twice(report_keyboard_t *sent, report_keyboard_t *staged, report_keyboard_t *next)
+{
+#ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) {
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_BITS; i++) {
+            if ((sent->nkro.bits[i] ^ staged->nkro.bits[i]) & (staged->nkro.bits[i] ^ next->nkro.bits[i])) return true;
+        }
+        return false;
+    }
+#endif
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t code = sent->keys[i];
+        if (code && !report_has_key(staged, code) && report_has_key(next, code)) return true;
+        code = staged->keys[i];
+        if (code && !report_has_key(sent, code) && !report_has_key(next, code)) return true;
+    }
+    return false;
+}
+
+static bool keys_differ(report_keyboard_t *a, report_keyboard_t *b)
+{
+#ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) {
+        return memcmp(a->nkro.bits, b->nkro.bits, sizeof(a->nkro.bits)) != 0;
+    }
+#endif
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (a->keys[i] && !report_has_key(b, a->keys[i])) return true;
+        if (b->keys[i] && !report_has_key(a, b->keys[i])) return true;
+    }
+    return false;
+}
+
+/** \brief Can merge
+ *
+ * Whether next can replace the staged report without the host missing a
+ * change: no key or modifier may go down and up (or up and down) unseen,
+ * and modifier changes get a report of their own before or after key
+ * changes, in the order they were made.
+ */
+static bool can_merge(report_keyboard_t *next)
+{
+    uint8_t staged_mods = report_mods(&sent_report) ^ report_mods(&staged_report);
+    uint8_t next_mods   = report_mods(&staged_report) ^ report_mods(next);
+
+    if (staged_mods & next_mods) return false;
+    if (staged_mods && keys_differ(&staged_report, next)) return false;
+    if (next_mods && keys_differ(&sent_report, &staged_report)) return false;
+    return !keys_changed_twice(&sent_report, &staged_report, next);
+}
+
+/** \brief Send the staged keyboard report
+ *
+ * Keyboard reports are staged by host_keyboard_send() and merged until this
+ * is called, once per keyboard_task() and before anything that waits or
+ * sends on another endpoint. Reports equal to the last one sent are skipped.
+ */
+void host_keyboard_flush(void)
+{
+    if (!report_staged) return;
+    report_staged = false;
+    if (!driver) return;
+    if (sent_report_valid && memcmp(&sent_report, &staged_report, sizeof(sent_report)) == 0) return;
+
+    sent_report       = staged_report;
+    sent_report_valid = true;
+    send_keyboard(&sent_report);
+}
+#endif
+
 /* send report */
 void host_keyboard_send(report_keyboard_t *report)
 {
@@ -65,20 +186,21 @@ void host_keyboard_send(report_keyboard_t *report)
         report->report_id = REPORT_ID_KEYBOARD;
 #endif
     }
-    (*driver->send_keyboard)(report);
-
-    if (debug_keyboard) {
-        dprint("keyboard_report: ");
-        for (uint8_t i = 0; i < KEYBOARD_REPORT_SIZE; i++) {
-            dprintf("%02X ", report->raw[i]);
-        }
-        dprint("\n");
+#ifdef KEYBOARD_REPORT_COALESCE
+    if (report_staged && !can_merge(report)) {
+        host_keyboard_flush();
     }
+    staged_report = *report;
+    report_staged = true;
+#else
+    send_keyboard(report);
+#endif
 }
 
 void host_mouse_send(report_mouse_t *report)
 {
     if (!driver) return;
+    host_keyboard_flush();
 #ifdef MOUSE_SHARED_EP
     report->report_id = REPORT_ID_MOUSE;
 #endif
@@ -91,6 +213,7 @@ void host_system_send(uint16_t report)
     last_system_report = report;
 
     if (!driver) return;
+    host_keyboard_flush();
     (*driver->send_system)(report);
 }
 
@@ -100,6 +223,7 @@ void host_consumer_send(uint16_t report)
     last_consumer_report = report;
 
     if (!driver) return;
+    host_keyboard_flush();
     (*driver->send_consumer)(report);
 }
 
@@ -46,6 +46,12 @@ void host_mouse_send(report_mouse_t *report);
 void host_system_send(uint16_t data);
 void host_consumer_send(uint16_t data);
 
+#ifdef KEYBOARD_REPORT_COALESCE
+void host_keyboard_flush(void);
+#else
+#define host_keyboard_flush()
+#endif
+
 uint16_t host_last_system_report(void);
 uint16_t host_last_consumer_report(void);
 
@@ -81,6 +81,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VELOCIKEY_ENABLE
   #include "velocikey.h"
 #endif
+#include "scan_profile.h"
 
 #ifdef MATRIX_HAS_GHOST
 extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
@@ -244,6 +245,62 @@ void keyboard_init(void) {
     keymap_config.nkro = 1;
 #endif
     keyboard_post_init_kb(); /* Always keep this last */
+    host_keyboard_flush();
+}
+
+/** \brief Maximum number of key events handled per scan
+ *
+ * Changed keys found while diffing the matrix are queued and drained in
+ * the same scan. Edges that don't fit in the queue stay unprocessed in
+ * matrix_prev and are picked up again on the next scan.
+ */
+#ifndef QMK_KEYS_PER_SCAN
+#   define QMK_KEYS_PER_SCAN 8
+#endif
+
+#if QMK_KEYS_PER_SCAN < 1 || QMK_KEYS_PER_SCAN > 255
+#   error "QMK_KEYS_PER_SCAN must be between 1 and 255"
+#endif
+
+static keyevent_t key_events[QMK_KEYS_PER_SCAN];
+static matrix_row_t matrix_prev[MATRIX_ROWS];
+
+/** \brief Collect key events
+ *
+ * Diffs the whole matrix against the last processed state and queues an
+ * event for every edge, all stamped with the time of this scan. Keys are
+ * marked processed as they are queued.
+ */
+static uint8_t keyboard_collect_events(void)
+{
+    uint8_t count = 0;
+    uint16_t time = timer_read() | 1; /* time should not be 0 */
+
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        matrix_row_t matrix_row = matrix_get_row(r);
+        matrix_row_t matrix_change = matrix_row ^ matrix_prev[r];
+        if (!matrix_change) { continue; }
+#ifdef MATRIX_HAS_GHOST
+        if (has_ghost_in_row(r, matrix_row)) { continue; }
+#endif
+        if (debug_matrix) matrix_print();
+        for (uint8_t c = 0; c < MATRIX_COLS; c++) {
+            matrix_row_t col_mask = ((matrix_row_t)1<<c);
+            if (matrix_change & col_mask) {
+                if (count >= QMK_KEYS_PER_SCAN) {
+                    return count;
+                }
+                key_events[count++] = (keyevent_t){
+                    .key = (keypos_t){ .row = r, .col = c },
+                    .pressed = (matrix_row & col_mask),
+                    .time = time
+                };
+                // record a processed key
+                matrix_prev[r] ^= col_mask;
+            }
+        }
+    }
+    return count;
 }
 
 /** \brief Keyboard task: Do keyboard routine jobs
@@ -260,64 +317,41 @@ void keyboard_init(void) {
  */
 void keyboard_task(void)
 {
-    static matrix_row_t matrix_prev[MATRIX_ROWS];
     static uint8_t led_status = 0;
-    matrix_row_t matrix_row = 0;
-    matrix_row_t matrix_change = 0;
-#ifdef QMK_KEYS_PER_SCAN
     uint8_t keys_processed = 0;
-#endif
 
+    SCAN_PROFILE_BEGIN(PROFILE_KEYBOARD_TASK);
+    SCAN_PROFILE_BEGIN(PROFILE_MATRIX_SCAN);
 #if defined(OLED_DRIVER_ENABLE) && !defined(OLED_DISABLE_TIMEOUT)
     uint8_t ret = matrix_scan();
 #else
     matrix_scan();
 #endif
+    SCAN_PROFILE_END(PROFILE_MATRIX_SCAN);
 
+    SCAN_PROFILE_BEGIN(PROFILE_ACTION_EXEC);
     if (is_keyboard_master()) {
-        for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
-            matrix_row = matrix_get_row(r);
-            matrix_change = matrix_row ^ matrix_prev[r];
-            if (matrix_change) {
-#ifdef MATRIX_HAS_GHOST
-                if (has_ghost_in_row(r, matrix_row)) { continue; }
-#endif
-                if (debug_matrix) matrix_print();
-                for (uint8_t c = 0; c < MATRIX_COLS; c++) {
-                    if (matrix_change & ((matrix_row_t)1<<c)) {
-                        action_exec((keyevent_t){
-                            .key = (keypos_t){ .row = r, .col = c },
-                            .pressed = (matrix_row & ((matrix_row_t)1<<c)),
-                            .time = (timer_read() | 1) /* time should not be 0 */
-                        });
-                        // record a processed key
-                        matrix_prev[r] ^= ((matrix_row_t)1<<c);
-#ifdef QMK_KEYS_PER_SCAN
-                        // only jump out if we have processed "enough" keys.
-                        if (++keys_processed >= QMK_KEYS_PER_SCAN)
-#endif
-                        // process a key per task call
-                        goto MATRIX_LOOP_END;
-                    }
-                }
-            }
+        keys_processed = keyboard_collect_events();
+        // drain the queue in matrix order
+        for (uint8_t i = 0; i < keys_processed; i++) {
+            action_exec(key_events[i]);
         }
     }
     // call with pseudo tick event when no real key event.
-#ifdef QMK_KEYS_PER_SCAN
-    // we can get here with some keys processed now.
-    if (!keys_processed)
-#endif
-    action_exec(TICK);
-
-MATRIX_LOOP_END:
+    if (!keys_processed) {
+        action_exec(TICK);
+    }
+    host_keyboard_flush();
+    SCAN_PROFILE_END(PROFILE_ACTION_EXEC);
 
 #ifdef QWIIC_ENABLE
     qwiic_task();
 #endif
 
 #ifdef OLED_DRIVER_ENABLE
+    SCAN_PROFILE_BEGIN(PROFILE_OLED);
     oled_task();
+    SCAN_PROFILE_END(PROFILE_OLED);
 #ifndef OLED_DISABLE_TIMEOUT
     // Wake up oled if user is using those fabulous keys!
     if (ret)
@@ -327,7 +361,9 @@ MATRIX_LOOP_END:
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
+    SCAN_PROFILE_BEGIN(PROFILE_MOUSEKEY);
     mousekey_task();
+    SCAN_PROFILE_END(PROFILE_MOUSEKEY);
 #endif
 
 #ifdef PS2_MOUSE_ENABLE
@@ -367,6 +403,8 @@ MATRIX_LOOP_END:
         led_status = host_keyboard_leds();
         keyboard_set_leds(led_status);
     }
+
+    SCAN_PROFILE_END(PROFILE_KEYBOARD_TASK);
 }
 
 /** \brief keyboard set leds
@@ -0,0 +1,71 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "latency_trace.h"
+#include "timer.h"
+#include "print.h"
+
+static latency_trace_t trace;
+
+/* Time of the event that caused the next report. Event times have their low
+ * bit set, so 0 means the next report has no traced cause. */
+static uint16_t origin;
+
+/** \brief Set the event that causes the next keyboard report
+ *
+ * Returns the previous origin, so a deferred event can be traced and the
+ * current one restored afterwards. A time of 0 clears the origin.
+ */
+uint16_t latency_trace_origin(uint16_t time) {
+    uint16_t previous = origin;
+    origin            = time;
+    return previous;
+}
+
+/** \brief Record the latency of the current origin
+ *
+ * Called for every keyboard report. Only the first report after an event is
+ * counted, later ones (releases of a macro, mods cleanup) are not.
+ */
+void latency_trace_report(void) {
+    if (!origin) {
+        return;
+    }
+    // the event time can be a tick ahead of the timer
+    int16_t  elapsed = timer_read() - origin;
+    uint16_t ms      = elapsed < 0 ? 0 : elapsed;
+    origin           = 0;
+
+    sample_stats_add(&trace.ms, ms);
+    trace.last_ms = ms;
+}
+
+const latency_trace_t *latency_trace_get(void) { return &trace; }
+
+void latency_trace_reset(void) {
+    memset(&trace, 0, sizeof(trace));
+    origin = 0;
+}
+
+void latency_trace_print(void) {
+    print("\n\t- Key latency (ms) -\ncount min avg max last\n");
+    if (!trace.ms.count) {
+        print("0\n");
+        return;
+    }
+    xprintf("%lu %u %lu %u %u\n", (unsigned long)trace.ms.count, trace.ms.min, (unsigned long)sample_stats_average(&trace.ms), trace.ms.max, trace.last_ms);
+}
@@ -0,0 +1,53 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "sample_stats.h"
+
+/* Latency of key events, from the debounced matrix change stamped into
+ * keyevent_t.time to the first keyboard report sent because of the event.
+ * Events held back by tapping, combos or tap dance are measured to the
+ * report that finally carries them. */
+typedef struct {
+    sample_stats_t ms;
+    uint16_t       last_ms;
+} latency_trace_t;
+
+#ifdef LATENCY_TRACE_ENABLE
+
+/* The event whose time is passed is the cause of the next keyboard report.
+ * BEGIN/END switch to a deferred event and back to the one being processed. */
+#    define LATENCY_TRACE_EVENT(time) latency_trace_origin(time)
+#    define LATENCY_TRACE_BEGIN(name, time) uint16_t latency_trace_##name = latency_trace_origin(time)
+#    define LATENCY_TRACE_END(name) latency_trace_origin(latency_trace_##name)
+#    define LATENCY_TRACE_REPORT() latency_trace_report()
+
+uint16_t               latency_trace_origin(uint16_t time);
+void                   latency_trace_report(void);
+const latency_trace_t *latency_trace_get(void);
+void                   latency_trace_reset(void);
+void                   latency_trace_print(void);
+
+#else
+
+#    define LATENCY_TRACE_EVENT(time)
+#    define LATENCY_TRACE_BEGIN(name, time)
+#    define LATENCY_TRACE_END(name)
+#    define LATENCY_TRACE_REPORT()
+
+#endif
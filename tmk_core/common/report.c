@@ -23,37 +23,33 @@
 
 /** \brief has_anykey
  *
- * FIXME: Needs doc
+ * Returns the number of nonzero bytes in the key part of the report, so with
+ * NKRO on this counts bytes of the bitmap rather than keys.
  */
 uint8_t has_anykey(report_keyboard_t* keyboard_report)
 {
-    uint8_t cnt = 0;
-    uint8_t *p = keyboard_report->keys;
-    uint8_t lp = sizeof(keyboard_report->keys);
 #ifdef NKRO_ENABLE
     if (keyboard_protocol && keymap_config.nkro) {
-        p = keyboard_report->nkro.bits;
-        lp = sizeof(keyboard_report->nkro.bits);
+        return bytepop(keyboard_report->nkro.bits, sizeof(keyboard_report->nkro.bits));
     }
 #endif
-    while (lp--) {
-        if (*p++)
-            cnt++;
-    }
-    return cnt;
+    return bytepop(keyboard_report->keys, sizeof(keyboard_report->keys));
 }
 
 /** \brief get_first_key
  *
- * FIXME: Needs doc
+ * With NKRO on, returns the highest key of the first nonzero byte of the
+ * bitmap, or 0 when no key is down. Otherwise returns the first slot of the
+ * key array, or with USB_6KRO_ENABLE the first slot in use.
  */
 uint8_t get_first_key(report_keyboard_t* keyboard_report)
 {
 #ifdef NKRO_ENABLE
     if (keyboard_protocol && keymap_config.nkro) {
-        uint8_t i = 0;
-        for (; i < KEYBOARD_REPORT_BITS && !keyboard_report->nkro.bits[i]; i++)
-            ;
+        uint8_t i = bytefirst(keyboard_report->nkro.bits, KEYBOARD_REPORT_BITS);
+        if (i == KEYBOARD_REPORT_BITS) {
+            return 0;
+        }
         return i<<3 | biton(keyboard_report->nkro.bits[i]);
     }
 #endif
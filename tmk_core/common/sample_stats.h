@@ -0,0 +1,43 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* Count, total, min and max of a series of samples, the average is
+ * total / count. Used by scan_profile and latency_trace. */
+typedef struct {
+    uint32_t count;
+    uint32_t total;
+    uint16_t min;
+    uint16_t max;
+} sample_stats_t;
+
+static inline void sample_stats_add(sample_stats_t *stats, uint16_t sample) {
+    // halve the totals before they overflow, the average stays the same
+    if (stats->total + sample < stats->total) {
+        stats->total >>= 1;
+        stats->count >>= 1;
+    }
+    stats->total += sample;
+    stats->count++;
+
+    if (stats->count == 1 || sample < stats->min) stats->min = sample;
+    if (sample > stats->max) stats->max = sample;
+}
+
+static inline uint32_t sample_stats_average(const sample_stats_t *stats) { return stats->count ? stats->total / stats->count : 0; }
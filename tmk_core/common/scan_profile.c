@@ -0,0 +1,93 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "scan_profile.h"
+#include "timer.h"
+#include "print.h"
+
+static scan_profile_t profile[PROFILE_STAGES];
+
+/** \brief Record a stage
+ *
+ * Adds the time since start_ticks, taken with timer_read_ticks(), to the
+ * statistics of the stage.
+ */
+void scan_profile_record(uint8_t stage, uint32_t start_ticks) {
+    uint32_t        elapsed = timer_elapsed_us(start_ticks);
+    uint16_t        us      = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+    scan_profile_t *p       = &profile[stage];
+
+    sample_stats_add(&p->us, us);
+
+    uint8_t bucket = 0;
+    while (us >>= 1) {
+        bucket++;
+    }
+    if (bucket >= SCAN_PROFILE_BUCKETS) {
+        bucket = SCAN_PROFILE_BUCKETS - 1;
+    }
+    if (p->histogram[bucket] < UINT16_MAX) {
+        p->histogram[bucket]++;
+    }
+}
+
+const scan_profile_t *scan_profile_get(uint8_t stage) { return stage < PROFILE_STAGES ? &profile[stage] : NULL; }
+
+void scan_profile_reset(void) { memset(profile, 0, sizeof(profile)); }
+
+static void print_stage_name(uint8_t stage) {
+    switch (stage) {
+        case PROFILE_KEYBOARD_TASK:
+            print("task");
+            break;
+        case PROFILE_MATRIX_SCAN:
+            print("matrix");
+            break;
+        case PROFILE_ACTION_EXEC:
+            print("action");
+            break;
+        case PROFILE_RGB_MATRIX:
+            print("rgb");
+            break;
+        case PROFILE_OLED:
+            print("oled");
+            break;
+        case PROFILE_MOUSEKEY:
+            print("mouse");
+            break;
+    }
+}
+
+/** \brief Print the statistics of every stage that ran
+ *
+ * One line per stage: count, min/avg/max in us, then the histogram buckets.
+ */
+void scan_profile_print(void) {
+    print("\n\t- Scan profile (us) -\nstage count min avg max | histogram 1 2 4 8 ...\n");
+    for (uint8_t stage = 0; stage < PROFILE_STAGES; stage++) {
+        const scan_profile_t *p = &profile[stage];
+        if (!p->us.count) {
+            continue;
+        }
+        print_stage_name(stage);
+        xprintf(" %lu %u %lu %u |", (unsigned long)p->us.count, p->us.min, (unsigned long)sample_stats_average(&p->us), p->us.max);
+        for (uint8_t bucket = 0; bucket < SCAN_PROFILE_BUCKETS; bucket++) {
+            xprintf(" %u", p->histogram[bucket]);
+        }
+        print("\n");
+    }
+}
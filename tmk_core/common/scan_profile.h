@@ -0,0 +1,61 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "timer.h"
+#include "sample_stats.h"
+
+/* Stages of keyboard_task() that are timed. Stages nest: matrix_scan()
+ * includes rgb_matrix_task(), and keyboard_task() includes everything. */
+enum scan_profile_stage {
+    PROFILE_KEYBOARD_TASK,
+    PROFILE_MATRIX_SCAN,
+    PROFILE_ACTION_EXEC,
+    PROFILE_RGB_MATRIX,
+    PROFILE_OLED,
+    PROFILE_MOUSEKEY,
+    PROFILE_STAGES
+};
+
+/* Histogram bucket n counts durations of 2^n to 2^(n+1) - 1 us, the last
+ * bucket also counts everything longer. */
+#ifndef SCAN_PROFILE_BUCKETS
+#    define SCAN_PROFILE_BUCKETS 12
+#endif
+
+typedef struct {
+    sample_stats_t us;
+    uint16_t       histogram[SCAN_PROFILE_BUCKETS];
+} scan_profile_t;
+
+#ifdef SCAN_PROFILE_ENABLE
+
+#    define SCAN_PROFILE_BEGIN(stage) uint32_t scan_profile_##stage = timer_read_ticks()
+#    define SCAN_PROFILE_END(stage) scan_profile_record(stage, scan_profile_##stage)
+
+void                  scan_profile_record(uint8_t stage, uint32_t start_ticks);
+const scan_profile_t *scan_profile_get(uint8_t stage);
+void                  scan_profile_reset(void);
+void                  scan_profile_print(void);
+
+#else
+
+#    define SCAN_PROFILE_BEGIN(stage)
+#    define SCAN_PROFILE_END(stage)
+
+#endif
@@ -46,6 +46,9 @@ uint32_t timer_read32(void);
 uint16_t timer_elapsed(uint16_t last);
 uint32_t timer_elapsed32(uint32_t last);
 
+uint32_t timer_read_ticks(void);
+uint32_t timer_elapsed_us(uint32_t start_ticks);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,69 @@
+/* Copyright 2019 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer.h"
+
+#if defined(__AVR__)
+#    include <avr/io.h>
+#    include <util/atomic.h>
+#elif defined(PROTOCOL_CHIBIOS)
+#    include "ch.h"
+#endif
+
+/** \brief Read the tick clock
+ *
+ * Returns a free running tick count with the best resolution the platform
+ * timer offers: the raw timer 0 count on AVR, the system tick on ChibiOS and
+ * the millisecond timer elsewhere.
+ */
+uint32_t timer_read_ticks(void) {
+#if defined(__AVR__)
+    uint32_t count;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        count = timer_count;
+        raw   = TIMER_RAW;
+#    ifndef __AVR_ATmega32A__
+        // the compare match is pending, the count is one millisecond late
+        if (TIFR0 & (1 << OCF0A)) {
+#    else
+        if (TIFR & (1 << OCF0)) {
+#    endif
+            count++;
+            raw = TIMER_RAW;
+        }
+    }
+    return count * TIMER_RAW_TOP + raw;
+#elif defined(PROTOCOL_CHIBIOS)
+    return chVTGetSystemTimeX();
+#else
+    return timer_read32();
+#endif
+}
+
+/** \brief Microseconds since start_ticks, taken with timer_read_ticks()
+ */
+uint32_t timer_elapsed_us(uint32_t start_ticks) {
+#if defined(__AVR__)
+    uint32_t ticks = timer_read_ticks() - start_ticks;
+    return ticks * 1000 / TIMER_RAW_TOP;
+#elif defined(PROTOCOL_CHIBIOS)
+    systime_t ticks = chVTGetSystemTimeX() - (systime_t)start_ticks;
+    return ST2US(ticks);
+#else
+    return (timer_read32() - start_ticks) * 1000;
+#endif
+}
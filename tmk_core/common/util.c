@@ -16,10 +16,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "util.h"
+#include <string.h>
+
+// AVR has no single cycle clz/popcount and handles one byte at a time anyway
+#if !defined(__AVR__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#   define UTIL_BUILTINS
+#endif
 
 // bit population - return number of on-bit
 uint8_t bitpop(uint8_t bits)
 {
+#ifdef UTIL_BUILTINS
+    return __builtin_popcount(bits);
+#else
     uint8_t c;
     for (c = 0; bits; c++)
         bits &= bits - 1;
@@ -28,47 +37,67 @@ uint8_t bitpop(uint8_t bits)
     const uint8_t bit_count[] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
     return bit_count[bits>>4] + bit_count[bits&0x0F]
 */
+#endif
 }
 
 uint8_t bitpop16(uint16_t bits)
 {
+#ifdef UTIL_BUILTINS
+    return __builtin_popcount(bits);
+#else
     uint8_t c;
     for (c = 0; bits; c++)
         bits &= bits - 1;
     return c;
+#endif
 }
 
 uint8_t bitpop32(uint32_t bits)
 {
+#ifdef UTIL_BUILTINS
+    return __builtin_popcount(bits);
+#else
     uint8_t c;
     for (c = 0; bits; c++)
         bits &= bits - 1;
     return c;
+#endif
 }
 
 // most significant on-bit - return highest location of on-bit
 // NOTE: return 0 when bit0 is on or all bits are off
 uint8_t biton(uint8_t bits)
 {
+#ifdef UTIL_BUILTINS
+    return bits ? 31 - __builtin_clz(bits) : 0;
+#else
     uint8_t n = 0;
     if (bits >> 4) { bits >>= 4; n += 4;}
     if (bits >> 2) { bits >>= 2; n += 2;}
     if (bits >> 1) { bits >>= 1; n += 1;}
     return n;
+#endif
 }
 
 uint8_t biton16(uint16_t bits)
 {
+#ifdef UTIL_BUILTINS
+    return bits ? 31 - __builtin_clz(bits) : 0;
+#else
     uint8_t n = 0;
     if (bits >> 8) { bits >>= 8; n += 8;}
     if (bits >> 4) { bits >>= 4; n += 4;}
     if (bits >> 2) { bits >>= 2; n += 2;}
     if (bits >> 1) { bits >>= 1; n += 1;}
     return n;
+#endif
 }
 
 uint8_t biton32(uint32_t bits)
 {
+#ifdef UTIL_BUILTINS
+    return bits ? 31 - __builtin_clz(bits) : 0;
+#else
     uint8_t n = 0;
     if (bits >>16) { bits >>=16; n +=16;}
     if (bits >> 8) { bits >>= 8; n += 8;}
@@ -76,9 +105,44 @@ uint8_t biton32(uint32_t bits)
     if (bits >> 2) { bits >>= 2; n += 2;}
     if (bits >> 1) { bits >>= 1; n += 1;}
     return n;
+#endif
 }
 
+// nonzero byte population - return number of bytes that are not zero
+uint8_t bytepop(const uint8_t *bytes, uint8_t len)
+{
+    uint8_t c = 0;
+#ifdef UTIL_BUILTINS
+    for (; len >= 4; len -= 4, bytes += 4) {
+        uint32_t w;
+        memcpy(&w, bytes, 4);
+        // sets the top bit of every nonzero byte and clears everything else
+        w = (((w & 0x7F7F7F7F) + 0x7F7F7F7F) | w) & 0x80808080;
+        c += __builtin_popcount(w);
+    }
+#endif
+    for (; len; len--) {
+        if (*bytes++) c++;
+    }
+    return c;
+}
 
+// first nonzero byte - return index of the first byte that is not zero
+// NOTE: return len when all bytes are zero
+uint8_t bytefirst(const uint8_t *bytes, uint8_t len)
+{
+    uint8_t i = 0;
+#ifdef UTIL_BUILTINS
+    for (; len - i >= 4; i += 4) {
+        uint32_t w;
+        memcpy(&w, bytes + i, 4);
+        if (w) return i + (__builtin_ctz(w) >> 3);
+    }
+#endif
+    for (; i < len && !bytes[i]; i++)
+        ;
+    return i;
+}
 
 uint8_t bitrev(uint8_t bits)
 {